@@ -7,10 +7,15 @@
  * Pure compile-time configuration. No object creation, no runtime pointers.
  * Buffer sizes are auto-calculated from display dimensions.
  *
- * Modify these values to match your hardware setup.
+ * Modify these values to match your hardware setup. ConfigCheck.hpp validates them
+ * at compile time (IDs, CC ranges, pins, buffer sizes).
  */
 
+#include "input/GestureEngine.hpp"
+#include "model/Parameter.hpp"
+
 #include <array>
+#include <utility>
 
 #include <oc/common/ButtonDef.hpp>
 #include <oc/common/EncoderDef.hpp>
@@ -27,18 +32,44 @@ namespace Config {
 /**
  * System timing constants controlling responsiveness vs CPU load.
  *
- * APP_HZ controls encoder/button polling. Too low = missed encoder steps.
+ * APP_HZ controls encoder/button polling. Too low = missed encoder steps, unless
+ * every encoder uses the QUAD_DECODER backend (Config::Encoder::BACKENDS).
  * LVGL_HZ controls UI refresh. Must be <= APP_HZ.
+ *
+ * SLEEP_WHEN_IDLE: between app ticks the core sleeps (WFI) until an interrupt
+ * instead of spinning on micros() (power::TickClock); false = spin.
  */
 namespace Timing {
-constexpr uint32_t APP_HZ = 2000;  // WARNING: Below 1000 Hz may miss encoder steps at fast rotation
+constexpr uint32_t APP_HZ = 2000;  // WARNING: Below 1000 Hz may miss INTERRUPT encoder steps
 constexpr uint32_t LVGL_HZ = 100;
+constexpr bool SLEEP_WHEN_IDLE = true;
+constexpr uint8_t TICK_PRIORITY = 224;  // Lowest: the tick ISR only flags the tick
 
 constexpr uint16_t LONG_PRESS_MS = 500;
 constexpr uint16_t DOUBLE_TAP_MS = 300;
+constexpr uint16_t HOLD_REPEAT_MS = 100;  // Repeat period of HOLD_REPEAT gestures
 constexpr uint8_t DEBOUNCE_MS = 5;  // Increase to 10-20 if buttons trigger multiple times
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// POWER
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Core clock governor (power::Governor).
+ *
+ * After IDLE_AFTER_MS without input or display invalidation the core runs at
+ * IDLE_HZ; the first input or redraw restores FULL_HZ (board_build.f_cpu) before it
+ * is processed. Timers, USB and the display SPI keep their rates at either clock.
+ */
+namespace Power {
+constexpr bool ENABLED = true;
+constexpr uint32_t FULL_HZ = F_CPU;
+constexpr uint32_t IDLE_HZ = 150'000'000;  // Any set_arm_clock() frequency >= 24 MHz
+constexpr uint32_t IDLE_AFTER_MS = 10'000;
+static_assert(IDLE_HZ >= 24'000'000 && IDLE_HZ <= FULL_HZ, "IDLE_HZ: 24 MHz to FULL_HZ");
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONTEXT IDS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -47,18 +78,21 @@ constexpr uint8_t DEBOUNCE_MS = 5;  // Increase to 10-20 if buttons trigger mult
  * User-defined context identifiers.
  *
  * Used for type-safe context registration and switching.
- * Values must be < 16 (MAX_CONTEXTS).
+ * Values must be < MAX_CONTEXTS (checked in ConfigCheck.hpp).
  *
  * _COUNT is optional but enables compile-time array sizing.
  */
 enum class ContextID : uint8_t {
     STANDALONE = 0,
+    DAW = 1,
     // Add more contexts here:
-    // BITWIG = 1,
-    // ABLETON = 2,
+    // BITWIG = 2,
+    // ABLETON = 3,
     _COUNT
 };
 
+constexpr size_t MAX_CONTEXTS = 16;  // Framework context table
+
 // ═══════════════════════════════════════════════════════════════════════════
 // DISPLAY
 // ═══════════════════════════════════════════════════════════════════════════
@@ -112,6 +146,29 @@ constexpr size_t DIFF_SIZE = CONFIG.recommendedDiffSize();
  * Memory usage (320x240 RGB565):
  *   - FULL mode:    ~150 KB (best quality and performances, no flicker)
  *   - PARTIAL mode: ~20-40 KB (may flicker on fast animations)
+ *
+ * LABEL_CACHE_BYTES caps pre-rasterized static labels (3 bytes/pixel, RGB565A8).
+ * Labels that do not fit fall back to regular lv_label rendering.
+ *
+ * VIEW_CACHE_BYTES caps LVGL memory kept by hidden views of inactive contexts
+ * (instant switch back). VIEW_RESERVE_BYTES is the LVGL pool headroom kept free;
+ * least-recently-used hidden views are released when either limit is hit.
+ *
+ * Frame pacing (ui::FramePacer): the panel period is measured at boot over
+ * CALIBRATION_FRAMES refreshes, then each frame starts so it is flushed
+ * FRAME_MARGIN_US before its vsync. The margin covers the start delay (up to one
+ * app tick). Every PROBE_FRAMES rendered frames one frame is rendered a refresh early
+ * to re-measure the vsync phase (never while the panel is idle: see Power).
+ *
+ * RENDER_BUDGET_US: longest a frame should block the loop (ui::FrameBudget). App
+ * ticks wait for the render, so it bounds input-to-MIDI latency; it is lowered to
+ * what the mux/matrix scan queues buffer. After a frame over budget, MIDI feedback
+ * redraws and animation steps are deferred until the backlog fits.
+ *
+ * Encoder smoothing (ui::Smoother): encoder widgets glide to new values, all of
+ * them stepped once per frame (no lv_anim_t per update). SPRING = critically
+ * damped, EXPONENTIAL = first order, OFF = jump. SMOOTHING_MS is the time constant:
+ * a steady sweep is shown 2x (SPRING) or 1x (EXPONENTIAL) that much later.
  */
 namespace LVGL {
 constexpr oc::ui::lvgl::BridgeConfig CONFIG = {
@@ -120,6 +177,21 @@ constexpr oc::ui::lvgl::BridgeConfig CONFIG = {
     .buffer2 = nullptr,                         // Buffering is optimized at driver level with ILI9341_T4 dep in the
                                                 // framework driver (only compatible w/ Teensy 4.x)
     .refreshHz = Timing::LVGL_HZ};
+
+constexpr size_t LABEL_CACHE_BYTES = 16 * 1024;
+constexpr size_t VIEW_CACHE_BYTES = 16 * 1024;  // Out of LVGL_MEMORY_POOL_SIZE_KB (lv_conf.h)
+constexpr size_t VIEW_RESERVE_BYTES = 8 * 1024;
+
+constexpr uint8_t CALIBRATION_FRAMES = 32;  // ~0.3 s at boot
+constexpr uint32_t FRAME_MARGIN_US = 700;
+constexpr uint16_t PROBE_FRAMES = 128;
+constexpr uint32_t RENDER_BUDGET_US = 4000;
+
+enum class Smoothing : uint8_t { OFF, EXPONENTIAL, SPRING };
+constexpr Smoothing SMOOTHING = Smoothing::SPRING;
+constexpr uint16_t SMOOTHING_MS = 12;
+static_assert(SMOOTHING_MS > 0, "SMOOTHING_MS: use Smoothing::OFF to disable");
+static_assert(FRAME_MARGIN_US > 1'000'000 / Timing::APP_HZ, "Margin must cover one app tick");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -153,7 +225,7 @@ enum class EncoderID : uint16_t {
  * Common issues:
  *   - Erratic values: Check PPR matches datasheet, increase APP_HZ
  *   - Wrong direction: Set invertDirection = true
- *   - Skipping steps: Reduce ticksPerEvent or increase APP_HZ
+ *   - Skipping steps: Reduce ticksPerEvent, increase APP_HZ or use QUAD_DECODER
  */
 namespace Encoder {
 using namespace oc::common;
@@ -170,6 +242,77 @@ constexpr std::array ENCODERS = {
     EncoderDef(EncoderID::ENC_2, 18, 19, PPR, RANGE, TICKS, INVERT),  // -> CC 61
     // Adjust to your needs, add more encoders here...
 };
+
+/**
+ * Parameter model, one entry per ENCODERS entry (same order).
+ *
+ * The encoder position (0-65535) is mapped to an integer output value, sent as CC:
+ *   - curve: LINEAR, LOG (fine control at the top) or EXP (fine control at the bottom)
+ *   - min/max: output range (0-127 for a CC)
+ *   - step: output quantum (e.g. 8 = 16 values over 0-127)
+ *   - detent: half-width of the center snap zone in position units (0 = none,
+ *     2048 = 1/32 of the travel on each side)
+ *
+ * Definition: { min, max, step, detent, curve } (model::ParamDef, model/Parameter.hpp)
+ */
+using model::Curve;
+using model::ParamDef;
+
+constexpr std::array PARAMS = {
+    //       min  max  step  detent  curve
+    ParamDef{0,   127, 1,    2048,   Curve::LINEAR},  // ENC 1: pan-like, center detent
+    ParamDef{0,   127, 1,    0,      Curve::EXP},     // ENC 2: fine control at low values
+};
+static_assert(PARAMS.size() == ENCODERS.size(), "One ParamDef per encoder");
+
+/**
+ * Encoder banks: BANKS sets of ENCODERS.size() values, one active at a time
+ * (Action::NEXT_BANK). Bank b sends CC ENC_CC_RANGE_START + b * ENCODERS.size() + i
+ * and keeps its own values; PARAMS apply to every bank.
+ */
+constexpr uint8_t BANKS = 8;
+
+/**
+ * Counting backend, one entry per ENCODERS entry (same order):
+ *   - INTERRUPT: pin-change interrupts in the framework, steps picked up by the app
+ *     tick (see APP_HZ)
+ *   - QUAD_DECODER: i.MX RT1062 ENC peripheral (input::QuadDecoder), counts every
+ *     edge in hardware whatever APP_HZ is. Up to 4 encoders; both pins must be
+ *     XBAR pins: 0, 1, 2, 3, 4, 5, 7, 8, 33, 36, 37 (checked at compile time)
+ */
+enum class Backend : uint8_t { INTERRUPT, QUAD_DECODER };
+
+constexpr std::array BACKENDS = {
+    Backend::INTERRUPT,  // ENC 1 (pins 22/23: no XBAR)
+    Backend::INTERRUPT,  // ENC 2 (pins 18/19: no XBAR)
+};
+static_assert(BACKENDS.size() == ENCODERS.size(), "One Backend per encoder");
+
+namespace detail {
+constexpr size_t INTERRUPT_COUNT = [] {
+    size_t count = 0;
+    for (Backend backend : BACKENDS) count += backend == Backend::INTERRUPT;
+    return count;
+}();
+
+constexpr std::array<size_t, INTERRUPT_COUNT> INTERRUPT_INDEX = [] {
+    std::array<size_t, INTERRUPT_COUNT> index{};
+    size_t n = 0;
+    for (size_t i = 0; i < BACKENDS.size(); ++i) {
+        if (BACKENDS[i] == Backend::INTERRUPT) index[n++] = i;
+    }
+    return index;
+}();
+
+template <size_t... I>
+constexpr auto interruptEncoders(std::index_sequence<I...>) {
+    return std::array<EncoderDef, sizeof...(I)>{ENCODERS[INTERRUPT_INDEX[I]]...};
+}
+}  // namespace detail
+
+/// ENCODERS entries with the INTERRUPT backend (the ones handed to the framework)
+constexpr auto INTERRUPT_ENCODERS =
+    detail::interruptEncoders(std::make_index_sequence<detail::INTERRUPT_COUNT>{});
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -198,7 +341,8 @@ enum class ButtonID : uint16_t {
  * Auto-generates: MIDI CC (Config::Midi::BTN_CC_RANGE_START + index).
  *
  * Definition: { id, {pin, source}, activeLow }
- * Source: MCU (direct GPIO) or MUX (via multiplexer)
+ * Source: MCU (direct GPIO) only. Multiplexed buttons are declared in Mux below and
+ * scanned by input::MuxScanner; ConfigCheck rejects Source::MUX here.
  */
 namespace Button {
 using namespace oc::common;
@@ -209,6 +353,53 @@ constexpr std::array BUTTONS = {
     ButtonDef(ButtonID::BTN_1, {32, Source::MCU}, true),  // -> CC 10
     // Adjust to your needs, add more buttons here...
 };
+
+/**
+ * Multiplexed button panels (74HC4067, 16 buttons per mux), scanned in the
+ * background by input::MuxScanner instead of app->update().
+ *
+ * A timer steps the shared address lines every STEP_US (the settle time before a
+ * sample) and samples one signal pin per mux; a full scan takes 16 * STEP_US and
+ * is debounced over DEBOUNCE_MS. Mux buttons follow BUTTONS in the button index
+ * (CC, state, gestures): BUTTONS.size() + mux * 16 + channel.
+ *
+ * 64 buttons = 4 muxes, e.g. SIGNAL_PINS = {14, 15, 16, 17}. Button CCs then
+ * reach past ENC_CC_RANGE_START: move the CC ranges (see MIDI), e.g. buttons from
+ * CC 33 and encoders from CC 98.
+ */
+namespace Mux {
+constexpr std::array<uint8_t, 4> ADDRESS_PINS = {2, 3, 4, 5};  // S0-S3, shared by all muxes
+constexpr std::array<uint8_t, 0> SIGNAL_PINS = {};             // SIG/COM of each mux
+
+constexpr bool ACTIVE_LOW = true;       // Buttons to GND, internal pull-ups
+constexpr uint32_t STEP_US = 20;        // Raise if a press shows on the next channel
+constexpr size_t FRAME_QUEUE = 8;       // Scans buffered between app updates (power of 2)
+constexpr uint8_t SCAN_PRIORITY = 160;  // Above MIDI capture, below USB
+}
+
+/**
+ * Key matrix (e.g. 8x8 = 64 keys on 16 pins), scanned in the background by
+ * input::MatrixScanner: a timer drives one row low every STEP_US (the other rows
+ * released) and reads the columns (internal pull-ups) once settled. A scan takes
+ * ROWS * STEP_US, independent of APP_HZ, and is debounced over DEBOUNCE_MS.
+ *
+ * DIODES = false: three keys on the corners of a rectangle make the fourth read as
+ * pressed (ghost). The rows concerned keep their last state while that is possible.
+ * Keys follow the mux buttons in the button index: ... + row * COLS + col.
+ */
+namespace Matrix {
+constexpr std::array<uint8_t, 0> ROW_PINS = {};  // e.g. {33, 34, 35, 36, 37, 38, 39, 40}
+constexpr std::array<uint8_t, 0> COL_PINS = {};  // e.g. {24, 25, 30, 31, 6, 7, 8, 9}
+
+constexpr bool DIODES = false;          // One diode per key: no ghosting, no row blocking
+constexpr uint32_t STEP_US = 50;        // Row settle time: 8 rows = 2.5 kHz scan rate
+constexpr size_t FRAME_QUEUE = 8;       // Scans buffered between app updates (power of 2)
+constexpr uint8_t SCAN_PRIORITY = 160;  // Above MIDI capture, below USB
+}
+
+/// All buttons: BUTTONS, then mux channels, then matrix keys
+constexpr size_t COUNT = BUTTONS.size() + Mux::SIGNAL_PINS.size() * 16 +
+                         Matrix::ROW_PINS.size() * Matrix::COL_PINS.size();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -216,15 +407,85 @@ constexpr std::array BUTTONS = {
 // ═══════════════════════════════════════════════════════════════════════════
 
 /**
- * USB MIDI output configuration.
+ * USB MIDI configuration.
  *
  * Requires -D USB_MIDI_SERIAL in platformio.ini build_flags.
- * CC numbers 0-13 are reserved (bank select, mod wheel, etc).
+ * CC ranges must stay within 0-119 (120-127 are channel mode messages), clear of
+ * bank select (CC 0 and 32) and of each other; ConfigCheck.hpp checks them.
+ *
+ * Incoming CCs on CHANNEL with the encoder CC numbers move the encoders (DAW feedback),
+ * except for an encoder turned in the last FEEDBACK_HOLDOFF_MS (the DAW echoing it).
+ * HIRES_CCS lists the incoming 14-bit controllers (MSB CC n = 1-31, LSB CC n + 32),
+ * merged into one value; every other CC is 7-bit. Their LSBs are reserved: no CC
+ * range may include them.
+ * Incoming packets are captured with their reception time by a timer ISR at
+ * IN_CAPTURE_HZ (MIDI clock timing resolution) into a ring of IN_QUEUE_SIZE packets.
+ * IN_PACKETS_PER_POLL bounds packets decoded per app update; larger bursts are
+ * spread over several updates.
+ *
+ * MIDI clock (DAW context): tick period tracked by a DLL of CLOCK_DLL_BANDWIDTH cycles
+ * per tick (lower = smoother, slower to follow tempo changes). A tick off by more than
+ * CLOCK_RELOCK_RATIO periods resets it; no tick for CLOCK_TIMEOUT_US = unlocked.
+ *
+ * SysEx bulk dump/restore (DAW context): F0 SYSEX_MANUFACTURER SYSEX_DEVICE cmd ... F7.
+ * 0x7D is the non-commercial manufacturer ID; device 0x7F addresses all devices.
  */
 namespace Midi {
 constexpr uint8_t CHANNEL = 0;              // 0-15, DAWs display as 1-16
 constexpr uint8_t BTN_CC_RANGE_START = 10;  // Buttons: CC 10, 11, 12...
-constexpr uint8_t ENC_CC_RANGE_START = 60;  // Encoders: CC 60, 61, 62...
+constexpr uint8_t ENC_CC_RANGE_START = 60;  // Encoders: CC 60, 61, 62... (bank 0 first)
+
+constexpr uint32_t FEEDBACK_HOLDOFF_MS = 50;  // > DAW echo round trip, < a deliberate pause
+
+constexpr std::array<uint8_t, 0> HIRES_CCS = {};
+// constexpr std::array<uint8_t, 2> HIRES_CCS = {1, 7};  // Mod wheel + volume (LSB 33, 39)
+
+constexpr uint32_t IN_CAPTURE_HZ = 10'000;   // 100 us clock timestamp resolution
+constexpr uint8_t IN_CAPTURE_PRIORITY = 192;  // Below USB and encoder interrupts
+constexpr size_t IN_QUEUE_SIZE = 256;         // Power of two, 8 bytes per packet
+constexpr size_t IN_PACKETS_PER_POLL = 64;
+
+constexpr double CLOCK_DLL_BANDWIDTH = 0.02;
+constexpr double CLOCK_RELOCK_RATIO = 0.5;
+constexpr uint32_t CLOCK_TIMEOUT_US = 250'000;  // 10 BPM
+
+constexpr uint8_t SYSEX_MANUFACTURER = 0x7D;
+constexpr uint8_t SYSEX_DEVICE = 0x00;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MODULATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Tempo-locked modulation of encoder CC output (DAW context, MIDI clock running).
+ *
+ * Each LFO adds depth * shape(phase) to its encoder's value before it is sent;
+ * the display keeps showing the encoder value. One cycle lasts `beats` quarter notes.
+ * STEPS plays the 8 `steps` values (-100..100 %) one per 1/8 cycle.
+ *
+ * Definition: { encoder index, shape, beats per cycle, depth (0-1), steps }
+ * LFOS is empty by default (no modulation). EXAMPLES rows are compiled and checked but
+ * not applied: `constexpr auto LFOS = EXAMPLES;` enables them.
+ */
+namespace Modulation {
+enum class Shape : uint8_t { SINE, TRIANGLE, SAW, SQUARE, STEPS };
+
+struct LfoDef {
+    uint8_t encoder;
+    Shape shape;
+    uint8_t beats;
+    float depth;
+    std::array<int8_t, 8> steps = {};
+};
+
+constexpr std::array EXAMPLES = {
+    //     encoder  shape            beats  depth
+    LfoDef{1,       Shape::TRIANGLE, 4,     0.25f},  // ENC 2: +/-25 %, one cycle per bar
+    LfoDef{0,       Shape::STEPS,    2,     0.5f,    {100, -100, 50, -50, 0, 0, 100, 0}},
+};
+
+constexpr std::array<LfoDef, 0> LFOS = {};
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -236,10 +497,51 @@ constexpr uint8_t ENC_CC_RANGE_START = 60;  // Encoders: CC 60, 61, 62...
  *
  * longPressMs: Duration to trigger long press (300-800 ms typical)
  * doubleTapWindowMs: Max gap between taps (too long delays single-tap response)
+ *
+ * GESTURES: button gestures -> actions, evaluated by input::GestureEngine.
+ * `buttons` is a mask of button indices (button(i) | button(j) for chords): BUTTONS,
+ * then scanned buttons (Button::COUNT); gestures see the first 64.
+ *   - PRESS:       on press, no delay
+ *   - TAP:         released before LONG_PRESS_MS (delayed by DOUBLE_TAP_MS when the same
+ *                  buttons also have a DOUBLE_TAP in the layer)
+ *   - DOUBLE_TAP:  second tap within DOUBLE_TAP_MS
+ *   - LONG_PRESS:  held LONG_PRESS_MS (once; no TAP on release)
+ *   - HOLD_REPEAT: held LONG_PRESS_MS, then every HOLD_REPEAT_MS
+ *   - CHORD:       all buttons down (any order); no TAP/LONG_PRESS for them until released
+ *   - SHIFT:       while held, only gestures of `layer` are active (layer 0 otherwise)
+ *
+ * Default table: button 1 carries TAP and DOUBLE_TAP, so the encoder reset fires on
+ * release + DOUBLE_TAP_MS (300 ms), not on press. For an instant reset, make it a PRESS
+ * (a double tap then also resets twice) or move NEXT_BANK to another button.
  */
 namespace Input {
 constexpr oc::core::InputConfig CONFIG = {.longPressMs = Timing::LONG_PRESS_MS,
                                           .doubleTapWindowMs = Timing::DOUBLE_TAP_MS};
+
+using input::button;
+using input::ButtonMask;
+using input::Gesture;
+
+constexpr input::GestureTiming TIMING = {Timing::LONG_PRESS_MS, Timing::DOUBLE_TAP_MS,
+                                         Timing::HOLD_REPEAT_MS};
+
+enum class Action : uint8_t { NONE, RESET_ENCODERS, NEXT_CONTEXT, NEXT_BANK };
+
+struct GestureDef {
+    Gesture gesture;
+    ButtonMask buttons;
+    uint8_t layer;
+    Action action;
+};
+
+constexpr std::array GESTURES = {
+    //         gesture               buttons    layer  action
+    GestureDef{Gesture::TAP,         button(0), 0,     Action::RESET_ENCODERS},  // +300 ms
+    GestureDef{Gesture::DOUBLE_TAP,  button(0), 0,     Action::NEXT_BANK},
+    GestureDef{Gesture::LONG_PRESS,  button(0), 0,     Action::NEXT_CONTEXT},
+    // GestureDef{Gesture::SHIFT,    button(1), 1,     Action::NONE},
+    // GestureDef{Gesture::CHORD,    button(0) | button(2), 0, Action::...},
+};
 }
 
 }  // namespace Config
@@ -0,0 +1,248 @@
+#pragma once
+
+/**
+ * @file ConfigCheck.hpp
+ * @brief Compile-time validation of Config.hpp
+ *
+ * Checks the whole configuration at once and fails the build with a message
+ * naming the setting to fix:
+ *   - IDs: encoder and button IDs unique, context IDs below MAX_CONTEXTS, LFO and
+ *     gesture references to existing encoders/buttons
+ *   - MIDI: channel, SysEx bytes, parameter output ranges, CC ranges within 0-119,
+ *     clear of bank select (CC 0/32), of 14-bit LSBs and of each other
+ *   - Pins: every pin used by the display, encoders, direct buttons, muxes and key
+ *     matrix exists on the board and is used once (mux and matrix pins only count
+ *     when that scanner is enabled); BUTTONS are direct (Source::MCU) pins
+ *   - Buffers: display buffers fit DMAMEM, view cache fits the LVGL pool, MIDI poll
+ *     bound fits the input queue
+ *
+ * Everything is static_assert over constexpr data: no code, no runtime check.
+ * Included once by main.cpp; checks tied to one module (scan queue sizes, XBAR
+ * pins, frame budget) stay in that module.
+ */
+
+#include "Config.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Config::check {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Defs>
+constexpr bool uniqueIds(const Defs& defs) {
+    for (size_t i = 0; i < defs.size(); ++i) {
+        for (size_t j = i + 1; j < defs.size(); ++j) {
+            if (defs[i].id == defs[j].id) return false;
+        }
+    }
+    return true;
+}
+
+template <typename Lfos>
+constexpr bool lfosTargetEncoders(const Lfos& lfos) {
+    for (const auto& lfo : lfos) {
+        if (lfo.encoder >= Encoder::ENCODERS.size()) return false;
+        if (lfo.depth < 0.0f || lfo.depth > 1.0f || lfo.beats == 0) return false;
+    }
+    return true;
+}
+
+constexpr bool gesturesTargetButtons() {
+    constexpr size_t usable = Button::COUNT < 64 ? Button::COUNT : 64;
+    constexpr Input::ButtonMask valid =
+        usable == 64 ? ~Input::ButtonMask(0) : Input::button(usable) - 1;
+    for (const auto& gesture : Input::GESTURES) {
+        if (!gesture.buttons || (gesture.buttons & ~valid)) return false;
+    }
+    return true;
+}
+
+static_assert(uniqueIds(Encoder::ENCODERS), "Config::Encoder: two ENCODERS share an EncoderID");
+static_assert(uniqueIds(Button::BUTTONS), "Config::Button: two BUTTONS share a ButtonID");
+static_assert(size_t(ContextID::_COUNT) <= MAX_CONTEXTS,
+              "Config::ContextID: values must be below MAX_CONTEXTS");
+static_assert(lfosTargetEncoders(Modulation::LFOS),
+              "Config::Modulation: LFO encoder index past ENCODERS, depth outside 0-1 or 0 beats");
+static_assert(lfosTargetEncoders(Modulation::EXAMPLES),
+              "Config::Modulation: EXAMPLES row invalid for these ENCODERS (see LFOS)");
+static_assert(gesturesTargetButtons(),
+              "Config::Input: gesture with no button or a button index past Button::COUNT");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MIDI
+// ═══════════════════════════════════════════════════════════════════════════
+
+/// CC 120-127 are channel mode messages (all notes off, reset...)
+constexpr size_t CC_LIMIT = 120;
+constexpr std::array<uint8_t, 2> BANK_SELECT_CCS = {0, 32};
+
+/// CCs [start, start + count)
+struct CcRange {
+    size_t start;
+    size_t count;
+
+    constexpr size_t end() const { return start + count; }
+    constexpr bool contains(size_t cc) const { return cc >= start && cc < end(); }
+};
+
+constexpr CcRange BUTTON_CCS = {Midi::BTN_CC_RANGE_START, Button::COUNT};
+constexpr CcRange ENCODER_CCS = {Midi::ENC_CC_RANGE_START,
+                                 Encoder::BANKS * Encoder::ENCODERS.size()};
+
+constexpr bool clearOfBankSelect(const CcRange& range) {
+    for (uint8_t cc : BANK_SELECT_CCS) {
+        if (range.contains(cc)) return false;
+    }
+    return true;
+}
+
+constexpr bool overlap(const CcRange& a, const CcRange& b) {
+    return a.count && b.count && a.start < b.end() && b.start < a.end();
+}
+
+/// 14-bit MSBs are 1-31; their LSBs (MSB + 32) are outside `range`
+constexpr bool hiresValid(const CcRange& range) {
+    for (uint8_t msb : Midi::HIRES_CCS) {
+        if (msb == 0 || msb >= 32 || range.contains(msb + 32)) return false;
+    }
+    return true;
+}
+
+constexpr bool paramsFitCc() {
+    for (const auto& param : Encoder::PARAMS) {
+        if (param.min < 0 || param.max > 127 || param.min >= param.max || param.step == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(Midi::CHANNEL <= 15, "Config::Midi: CHANNEL is 0-15");
+static_assert(Midi::SYSEX_MANUFACTURER <= 0x7F && Midi::SYSEX_DEVICE <= 0x7F,
+              "Config::Midi: SysEx IDs are 7-bit (0x00-0x7F)");
+static_assert(BUTTON_CCS.end() <= CC_LIMIT,
+              "Config::Midi: button CCs (BTN_CC_RANGE_START + Button::COUNT) run past CC 119");
+static_assert(ENCODER_CCS.end() <= CC_LIMIT,
+              "Config::Midi: encoder CCs (ENC_CC_RANGE_START + BANKS * encoders) run past CC "
+              "119");
+static_assert(clearOfBankSelect(BUTTON_CCS) && clearOfBankSelect(ENCODER_CCS),
+              "Config::Midi: a CC range includes bank select (CC 0 or 32)");
+static_assert(hiresValid(BUTTON_CCS) && hiresValid(ENCODER_CCS),
+              "Config::Midi: HIRES_CCS need MSBs 1-31, and no CC range may include their LSB "
+              "(MSB + 32)");
+static_assert(!overlap(BUTTON_CCS, ENCODER_CCS),
+              "Config::Midi: button CCs overlap encoder CCs: move BTN_CC_RANGE_START or "
+              "ENC_CC_RANGE_START");
+static_assert(paramsFitCc(), "Config::Encoder: PARAMS need 0 <= min < max <= 127 and step >= 1");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PINS
+// ═══════════════════════════════════════════════════════════════════════════
+
+constexpr uint8_t PIN_COUNT = 55;  ///< Teensy 4.1: pins 0-54
+constexpr uint8_t NO_PIN = 255;    ///< Unconnected (e.g. display reset)
+
+enum class Owner : uint8_t { DISPLAY, ENCODER, BUTTON, MUX, MATRIX };
+
+struct PinUse {
+    uint8_t pin;
+    Owner owner;
+};
+
+constexpr bool MUX_ENABLED = !Button::Mux::SIGNAL_PINS.empty();
+constexpr bool MATRIX_ENABLED =
+    !Button::Matrix::ROW_PINS.empty() && !Button::Matrix::COL_PINS.empty();
+
+constexpr size_t PIN_USES =
+    6 + 2 * Encoder::ENCODERS.size() + Button::BUTTONS.size() +
+    (MUX_ENABLED ? Button::Mux::ADDRESS_PINS.size() + Button::Mux::SIGNAL_PINS.size() : 0) +
+    (MATRIX_ENABLED ? Button::Matrix::ROW_PINS.size() + Button::Matrix::COL_PINS.size() : 0);
+
+/// Every pin in use, with its owner
+constexpr std::array<PinUse, PIN_USES> PINS = [] {
+    std::array<PinUse, PIN_USES> pins{};
+    size_t n = 0;
+    auto add = [&](uint8_t pin, Owner owner) { pins[n++] = {pin, owner}; };
+
+    const auto& display = Display::CONFIG;
+    for (uint8_t pin : {uint8_t(display.csPin), uint8_t(display.dcPin), uint8_t(display.rstPin),
+                        uint8_t(display.mosiPin), uint8_t(display.sckPin),
+                        uint8_t(display.misoPin)}) {
+        add(pin, Owner::DISPLAY);
+    }
+    for (const auto& def : Encoder::ENCODERS) {
+        add(def.pinA, Owner::ENCODER);
+        add(def.pinB, Owner::ENCODER);
+    }
+    for (const auto& def : Button::BUTTONS) add(def.pin.pin, Owner::BUTTON);
+    if (MUX_ENABLED) {
+        for (uint8_t pin : Button::Mux::ADDRESS_PINS) add(pin, Owner::MUX);
+        for (uint8_t pin : Button::Mux::SIGNAL_PINS) add(pin, Owner::MUX);
+    }
+    if (MATRIX_ENABLED) {
+        for (uint8_t pin : Button::Matrix::ROW_PINS) add(pin, Owner::MATRIX);
+        for (uint8_t pin : Button::Matrix::COL_PINS) add(pin, Owner::MATRIX);
+    }
+    return pins;
+}();
+
+/// BUTTONS are read by the framework on their own pin: a Source::MUX entry would take the
+/// framework's mux driver, not input::MuxScanner, and clash with its address lines
+constexpr bool buttonsDirect() {
+    for (const auto& def : Button::BUTTONS) {
+        if (def.pin.source != Button::Source::MCU) return false;
+    }
+    return true;
+}
+
+/// Pins of `owner` exist and are used nowhere else (including twice by `owner`)
+constexpr bool validPins(Owner owner) {
+    for (size_t i = 0; i < PINS.size(); ++i) {
+        if (PINS[i].owner != owner || PINS[i].pin == NO_PIN) continue;
+        if (PINS[i].pin >= PIN_COUNT) return false;
+        for (size_t j = 0; j < PINS.size(); ++j) {
+            if (j != i && PINS[j].pin == PINS[i].pin) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(buttonsDirect(),
+              "Config::Button: BUTTONS must be Source::MCU; declare multiplexed buttons as "
+              "Button::Mux::SIGNAL_PINS channels (input::MuxScanner)");
+static_assert(validPins(Owner::DISPLAY),
+              "Config::Display: pin past 54 or used twice / by another device");
+static_assert(validPins(Owner::ENCODER),
+              "Config::Encoder: pinA/pinB past 54 or used twice / by another device");
+static_assert(validPins(Owner::BUTTON),
+              "Config::Button: MCU button pin past 54 or used twice / by another device");
+static_assert(validPins(Owner::MUX),
+              "Config::Button::Mux: pin past 54 or used twice / by another device");
+static_assert(validPins(Owner::MATRIX),
+              "Config::Button::Matrix: pin past 54 or used twice / by another device");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BUFFERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+constexpr size_t DMAMEM_BYTES = 512 * 1024;  ///< RAM2 (OCRAM), shared with the heap
+constexpr size_t DISPLAY_BUFFER_BYTES = Display::BUFFER_SIZE * sizeof(uint16_t) +
+                                        2 * Display::DIFF_SIZE +
+                                        Display::BUFFER_SIZE * sizeof(lv_color_t);
+
+static_assert(Display::BUFFER_SIZE >= size_t(Display::CONFIG.width) * Display::CONFIG.height,
+              "Config::Display: BUFFER_SIZE smaller than width * height");
+static_assert(DISPLAY_BUFFER_BYTES < DMAMEM_BYTES,
+              "Config::Display: framebuffer + diffs + LVGL buffer exceed DMAMEM (512 KB)");
+static_assert(LVGL::VIEW_CACHE_BYTES + LVGL::VIEW_RESERVE_BYTES < LV_MEM_SIZE,
+              "Config::LVGL: VIEW_CACHE_BYTES + VIEW_RESERVE_BYTES exceed the LVGL pool "
+              "(LVGL_MEMORY_POOL_SIZE_KB in lv_conf.h)");
+static_assert(Midi::IN_PACKETS_PER_POLL > 0 && Midi::IN_PACKETS_PER_POLL <= Midi::IN_QUEUE_SIZE,
+              "Config::Midi: IN_PACKETS_PER_POLL is 1 to IN_QUEUE_SIZE");
+
+}  // namespace Config::check
@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file ContextSwitch.hpp
+ * @brief Deferred context switch requests and switch latency
+ *
+ * Contexts cannot switch themselves from an input callback (the active context
+ * would be cleaned up while its handler is still running). They post a request
+ * here; main loop() applies it between two app updates and measures it.
+ *
+ * Switch latency = old context cleanup + new context initialize (view shown
+ * from ViewPool or created lazily); the next LVGL refresh draws it.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+
+#include <optional>
+
+namespace context {
+
+namespace Switch {
+
+struct Stats {
+    uint32_t switches = 0;
+    uint32_t lastUs = 0;
+    uint32_t maxUs = 0;
+};
+
+inline Config::ContextID active = Config::ContextID::STANDALONE;
+inline std::optional<Config::ContextID> pending;
+inline Stats stats;
+
+/// Ask for a switch, applied by the main loop (last request wins)
+inline void request(Config::ContextID id) {
+    if (id != active) pending = id;
+}
+
+/// Context following `id` in ContextID order (wraps around)
+inline Config::ContextID next(Config::ContextID id) {
+    const auto count = uint8_t(Config::ContextID::_COUNT);
+    return Config::ContextID((uint8_t(id) + 1) % count);
+}
+
+/// Apply the pending request with switchFn(id) -> bool, timing it
+template <typename SwitchFn>
+inline bool apply(SwitchFn&& switchFn) {
+    if (!pending) return false;
+    const Config::ContextID id = *pending;
+    pending.reset();
+
+    const uint32_t start = micros();
+    if (!switchFn(id)) return false;
+    const uint32_t elapsed = micros() - start;
+
+    active = id;
+    ++stats.switches;
+    stats.lastUs = elapsed;
+    if (elapsed > stats.maxUs) stats.maxUs = elapsed;
+    return true;
+}
+
+}  // namespace Switch
+
+}  // namespace context
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file DawContext.hpp
+ * @brief DAW control context, second example of context switching
+ *
+ * Same controls and MIDI mapping as StandaloneContext, with its own state model
+ * and view: values survive switching back and forth between contexts.
+ *
+ * Also listens to the DAW: CCs received on the encoder CC numbers (parameter
+ * feedback, project load) move the encoders and sliders (MidiFeedback), and
+ * MIDI clock drives tempo-locked modulation of encoder CCs (ClockSync, Modulator).
+ *
+ * Switch with a long press on the first button (see Handler). The view stays
+ * alive while hidden as long as Config::LVGL::VIEW_CACHE_BYTES allows (ViewPool),
+ * so switching back only un-hides it.
+ */
+
+#include "Config.hpp"
+#include "handler/Handler.hpp"
+#include "handler/MidiFeedback.hpp"
+#include "handler/Modulator.hpp"
+#include "midi/ClockSync.hpp"
+#include "midi/UsbMidiInput.hpp"
+#include "model/ControlState.hpp"
+#include "ui/view/DemoView.hpp"
+#include "ui/view/ViewPool.hpp"
+
+#include <oc/context/IContext.hpp>
+#include <oc/context/Requirements.hpp>
+
+namespace context {
+
+/**
+ * @brief DAW mode context
+ *
+ * Orchestrates:
+ *   - Control state model (PanelState), separate from the standalone one
+ *   - View "daw" (DemoView titled "DAW"), created on first activation
+ *   - Input bindings via Handler
+ *   - MIDI input captured with reception timestamps (UsbMidiInput), decoded every
+ *     update into MidiFeedback (CC, SysEx) and ClockSync (clock, transport)
+ *   - Modulated CC output via Modulator, every update
+ */
+class DawContext : public oc::context::IContext {
+public:
+    static constexpr oc::context::Requirements REQUIRES{
+        .button = true,
+        .encoder = true,
+        .midi = true
+    };
+
+    ~DawContext() { ui::ViewPool::instance().remove(view_); }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // IContext Lifecycle
+    // ═══════════════════════════════════════════════════════════════════
+
+    bool initialize() override {
+        view_.setState(state_);
+        ui::ViewPool::instance().activate(view_);
+        handler_.setup(buttons(), encoders(), midi(), state_);
+        feedback_.setup(encoders(), state_, handler_);
+        modulator_.setup(midi(), state_, clock_, handler_);
+        midiIn_.begin();
+        return true;
+    }
+
+    void update() override {
+        if (midiIn_.poll(sinks_)) feedback_.flush();
+        modulator_.update();
+        handler_.update();
+    }
+
+    void cleanup() override {
+        midiIn_.end();
+        handler_.releaseButtons();
+        ui::ViewPool::instance().deactivate(view_);
+    }
+
+    const char* getName() const override { return "DAW"; }
+
+private:
+    model::PanelState state_;
+    ui::DemoView view_{"DAW", "daw"};
+    handler::Handler<model::PanelState> handler_;
+    handler::MidiFeedback<model::PanelState> feedback_;
+    handler::Modulator<model::PanelState> modulator_;
+    midi::ClockSync clock_{{Config::Midi::CLOCK_DLL_BANDWIDTH, Config::Midi::CLOCK_RELOCK_RATIO,
+                            Config::Midi::CLOCK_TIMEOUT_US}};
+    midi::SinkPair<decltype(feedback_), decltype(clock_)> sinks_{feedback_, clock_};
+    midi::UsbMidiInput midiIn_;
+};
+
+}  // namespace context
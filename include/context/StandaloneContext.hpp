@@ -22,7 +22,9 @@
 
 #include "Config.hpp"
 #include "handler/Handler.hpp"
+#include "model/ControlState.hpp"
 #include "ui/view/DemoView.hpp"
+#include "ui/view/ViewPool.hpp"
 
 #include <oc/context/IContext.hpp>
 #include <oc/context/Requirements.hpp>
@@ -33,7 +35,8 @@ namespace context {
  * @brief Standalone mode context
  *
  * Orchestrates:
- *   - View creation and lifecycle (DemoView)
+ *   - Control state model (PanelState), written by Handler, displayed by DemoView
+ *   - View creation and lifecycle (DemoView, kept hidden by ViewPool when inactive)
  *   - Input bindings via Handler
  *   - MIDI output
  *
@@ -54,25 +57,30 @@ public:
     // IContext Lifecycle
     // ═══════════════════════════════════════════════════════════════════
 
+    ~StandaloneContext() { ui::ViewPool::instance().remove(view_); }
+
     bool initialize() override {
-        view_.onActivate();
-        handler_.setup(buttons(), encoders(), midi(), view_);
+        view_.setState(state_);
+        ui::ViewPool::instance().activate(view_);
+        handler_.setup(buttons(), encoders(), midi(), state_);
         return true;
     }
 
     void update() override {
-        // View updates handled by LVGL refresh
+        handler_.update();  // Button gestures; view updates handled by LVGL refresh
     }
 
     void cleanup() override {
-        view_.onDeactivate();
+        handler_.releaseButtons();
+        ui::ViewPool::instance().deactivate(view_);
     }
 
     const char* getName() const override { return "Standalone"; }
 
 private:
+    model::PanelState state_;
     ui::DemoView view_;
-    handler::Handler<ui::DemoView> handler_;
+    handler::Handler<model::PanelState> handler_;
 };
 
 }  // namespace context
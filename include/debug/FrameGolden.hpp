@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file FrameGolden.hpp
+ * @brief Input script and golden frames of the render regression check (FrameProbe)
+ *
+ * FRAME_SCRIPT: one rendered frame per step, from a fresh DemoView (step 0 = first
+ * screen). FRAME_GOLDEN: { crc, renderUs } of each step's frame, same order.
+ *
+ * To (re)record, after an intended change to DemoView, the widgets or lv_conf.h:
+ * empty FRAME_GOLDEN, build with -D OC_FRAME_PROBE, boot once and copy the logged
+ * "step N: crc C, render U us" lines here as {C, U} rows. Record on the target at its
+ * production clock (board_build.f_cpu): render times are compared, not only CRCs.
+ */
+
+#include "Config.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace debug {
+
+/// One scripted input, written to the model like Handler does
+struct ProbeStep {
+    enum class Kind : uint8_t { NONE, ENCODER, BUTTON, BANK, RESET };
+
+    Kind kind;
+    uint8_t index;   ///< Encoder or button index
+    uint16_t value;  ///< ENCODER: raw position, BUTTON: pressed (0/1), BANK: bank index
+};
+
+/// Expected output of one script step
+struct FrameGolden {
+    uint32_t crc;
+    uint32_t renderUs;
+};
+
+/// Allowed render time increase over the recorded baseline
+constexpr uint8_t RENDER_TOLERANCE_PCT = 20;
+
+using Kind = ProbeStep::Kind;
+
+constexpr std::array FRAME_SCRIPT = {
+    //        kind           index  value
+    ProbeStep{Kind::NONE,    0,     0},      // First screen, every encoder centered
+    ProbeStep{Kind::ENCODER, 0,     0},      // ENC 1 to the bottom
+    ProbeStep{Kind::ENCODER, 0,     65535},  // ENC 1 to the top
+    ProbeStep{Kind::ENCODER, 0,     33000},  // ENC 1 inside the center detent
+    ProbeStep{Kind::ENCODER, 1,     16384},  // ENC 2 at a quarter (EXP curve)
+    ProbeStep{Kind::BUTTON,  0,     1},      // BTN 1 pressed
+    ProbeStep{Kind::BUTTON,  0,     0},      // BTN 1 released
+    ProbeStep{Kind::BANK,    0,     1},      // Bank 2: its own (centered) values
+    ProbeStep{Kind::ENCODER, 1,     60000},  // ENC 2 of bank 2
+    ProbeStep{Kind::BANK,    0,     0},      // Back to bank 1
+    ProbeStep{Kind::RESET,   0,     0},      // Reset encoders
+};
+
+/// Empty: record mode (see above)
+constexpr std::array<FrameGolden, 0> FRAME_GOLDEN{};
+
+namespace detail {
+constexpr bool validScript() {
+    for (const ProbeStep& step : FRAME_SCRIPT) {
+        switch (step.kind) {
+            case Kind::ENCODER:
+                if (step.index >= Config::Encoder::ENCODERS.size()) return false;
+                break;
+            case Kind::BUTTON:
+                if (step.index >= Config::Button::COUNT || step.value > 1) return false;
+                break;
+            case Kind::BANK:
+                if (step.value >= Config::Encoder::BANKS) return false;
+                break;
+            default: break;
+        }
+    }
+    return true;
+}
+}  // namespace detail
+
+static_assert(detail::validScript(), "FRAME_SCRIPT: index or bank beyond Config");
+static_assert(FRAME_GOLDEN.empty() || FRAME_GOLDEN.size() == FRAME_SCRIPT.size(),
+              "FRAME_GOLDEN: one row per FRAME_SCRIPT step (or none to record)");
+
+}  // namespace debug
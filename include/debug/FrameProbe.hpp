@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file FrameProbe.hpp
+ * @brief On-target render regression check: a committed input script played into
+ *        DemoView, each frame CRC'd and timed against golden values
+ *
+ * runFrameProbe() builds a DemoView with its own PanelState on a scratch screen and
+ * plays FRAME_SCRIPT (debug/FrameGolden.hpp). Each step writes the model the way
+ * Handler does (parameter mapping, button, bank switch, reset), then renders one
+ * frame with lv_refr_now(). Encoder values are shown without glide and the top and
+ * system layers (perf/memory monitors) are hidden, so a frame depends on the script
+ * only, not on timing.
+ *
+ * Each frame gets a CRC-32 of its visible pixels and a render + flush time, checked
+ * against FRAME_GOLDEN[step]: same CRC, time within RENDER_TOLERANCE_PCT. The script
+ * is played twice, on fresh views: the second pass must reproduce the CRCs of the
+ * first, with or without a golden table.
+ *
+ * Enabled with -D OC_FRAME_PROBE in platformio.ini build_flags: main.cpp runs it at
+ * boot, before the contexts create their views, logs each frame, dumps mismatching
+ * frames as PPM (dumpPpm) and halts on failure. With an empty golden table frames
+ * are only logged, ready to be copied into FRAME_GOLDEN (record mode).
+ */
+
+#include <Arduino.h>
+
+#include "debug/FrameGolden.hpp"
+#include "model/ControlState.hpp"
+#include "ui/view/DemoView.hpp"
+
+#include <array>
+
+#include <lvgl.h>
+
+namespace debug {
+
+/// One rendered script step
+struct ProbeFrame {
+    size_t step = 0;
+    uint8_t pass = 0;           ///< 0: against FRAME_GOLDEN, 1: against pass 0
+    uint32_t crc = 0;
+    uint32_t renderUs = 0;
+    bool crcMismatch = false;   ///< Differs from the golden CRC
+    bool slow = false;          ///< Render time above baseline + tolerance
+    bool unstable = false;      ///< Pass 1 differs from pass 0 (non-deterministic frame)
+};
+
+struct ProbeResult {
+    uint32_t frames = 0;
+    uint32_t crcMismatches = 0;
+    uint32_t slowFrames = 0;
+    uint32_t unstableFrames = 0;
+    bool recording = FRAME_GOLDEN.empty();  ///< No golden values: frames only logged
+
+    bool passed() const { return crcMismatches == 0 && slowFrames == 0 && unstableFrames == 0; }
+};
+
+namespace detail {
+constexpr std::array<uint32_t, 256> makeCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+/// CRC-32 (IEEE 802.3, reflected) of a byte range
+inline uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    crc = ~crc;
+    while (size--) crc = CRC_TABLE[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/// CRC of the visible pixels only (stride padding excluded)
+inline uint32_t frameCrc(const lv_draw_buf_t& frame) {
+    const uint32_t rowBytes = frame.header.w * sizeof(uint16_t);
+    uint32_t crc = 0;
+    for (uint32_t y = 0; y < frame.header.h; ++y) {
+        crc = crc32(frame.data + y * frame.header.stride, rowBytes, crc);
+    }
+    return crc;
+}
+
+/// Same model writes as Handler for the same input
+inline void apply(const ProbeStep& step, model::PanelState& state) {
+    using Kind = ProbeStep::Kind;
+    switch (step.kind) {
+        case Kind::NONE: break;
+        case Kind::ENCODER:
+            state.setEncoder(step.index,
+                             model::ENCODER_PARAMETERS[step.index].apply(step.value).position);
+            break;
+        case Kind::BUTTON: state.setButton(step.index, step.value != 0); break;
+        case Kind::BANK: state.setBank(step.value, micros()); break;
+        case Kind::RESET: state.resetEncoders(); break;
+    }
+}
+
+/// Hide/show the layers drawn over every screen (LVGL perf and memory monitors)
+inline void setOverlaysHidden(lv_display_t* display, bool hidden) {
+    for (lv_obj_t* layer : {lv_display_get_layer_top(display), lv_display_get_layer_sys(display)}) {
+        if (hidden) {
+            lv_obj_add_flag(layer, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_remove_flag(layer, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+}  // namespace detail
+
+/**
+ * @brief Play FRAME_SCRIPT twice; onFrame(const ProbeFrame&, const lv_draw_buf_t& frame)
+ *        after each rendered step (frame: the LVGL buffer, valid during the call)
+ */
+template <typename OnFrame>
+ProbeResult runFrameProbe(lv_display_t* display, OnFrame&& onFrame) {
+    ProbeResult result;
+    std::array<uint32_t, FRAME_SCRIPT.size()> firstPass{};
+
+    lv_obj_t* previous = lv_screen_active();
+    detail::setOverlaysHidden(display, true);
+
+    for (uint8_t pass = 0; pass < 2; ++pass) {
+        lv_obj_t* screen = lv_obj_create(nullptr);
+        lv_screen_load(screen);
+
+        model::PanelState state;
+        ui::DemoView view;
+        view.setState(state);
+        view.onActivate();
+
+        for (size_t step = 0; step < FRAME_SCRIPT.size(); ++step) {
+            detail::apply(FRAME_SCRIPT[step], state);
+            view.snapNext();
+
+            const uint32_t start = micros();
+            lv_refr_now(display);
+            const uint32_t renderUs = micros() - start;
+
+            const lv_draw_buf_t* buffer = lv_display_get_buf_active(display);
+            if (!buffer) continue;
+
+            ProbeFrame frame;
+            frame.step = step;
+            frame.pass = pass;
+            frame.crc = detail::frameCrc(*buffer);
+            frame.renderUs = renderUs;
+            if (pass == 0) {
+                firstPass[step] = frame.crc;
+                if (!result.recording) {
+                    const FrameGolden& golden = FRAME_GOLDEN[step];
+                    frame.crcMismatch = frame.crc != golden.crc;
+                    frame.slow = renderUs >
+                                 golden.renderUs + golden.renderUs * RENDER_TOLERANCE_PCT / 100;
+                }
+            } else {
+                frame.unstable = frame.crc != firstPass[step];
+            }
+
+            ++result.frames;
+            result.crcMismatches += frame.crcMismatch;
+            result.slowFrames += frame.slow;
+            result.unstableFrames += frame.unstable;
+            onFrame(frame, *buffer);
+        }
+
+        view.onDeactivate();
+        view.release();
+        lv_screen_load(previous);
+        lv_obj_delete(screen);
+    }
+
+    detail::setOverlaysHidden(display, false);
+    lv_obj_invalidate(previous);
+    return result;
+}
+
+/// Binary PPM (P6) of an RGB565 frame on Serial, between "PPM BEGIN"/"PPM END" lines
+inline void dumpPpm(const lv_draw_buf_t& frame) {
+    Serial.print("PPM BEGIN\nP6\n");
+    Serial.print(frame.header.w);
+    Serial.print(' ');
+    Serial.print(frame.header.h);
+    Serial.print("\n255\n");
+    uint8_t rgb[3];
+    for (uint32_t y = 0; y < frame.header.h; ++y) {
+        const auto* row = reinterpret_cast<const uint16_t*>(frame.data + y * frame.header.stride);
+        for (uint32_t x = 0; x < frame.header.w; ++x) {
+            const uint16_t c = row[x];
+            rgb[0] = uint8_t(((c >> 11) & 0x1F) * 255 / 31);
+            rgb[1] = uint8_t(((c >> 5) & 0x3F) * 255 / 63);
+            rgb[2] = uint8_t((c & 0x1F) * 255 / 31);
+            Serial.write(rgb, sizeof(rgb));
+        }
+    }
+    Serial.print("\nPPM END\n");
+}
+
+}  // namespace debug
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file WidgetBench.hpp
+ * @brief On-target benchmark of the encoder widgets: objects, invalidated pixels and
+ *        render time per step
+ *
+ * benchWidget<Widget>() builds a column of widgets on a scratch screen (laid out
+ * like DemoView's encoder column) and renders it once. Then, for `steps` frames,
+ * it moves every widget by one encoder step (1/64 of the travel, sweeping up and
+ * back). It sums the areas the widgets invalidate (LV_EVENT_INVALIDATE_AREA) and
+ * times lv_refr_now() (render + flush).
+ * The active screen is restored and the scratch screen deleted afterwards.
+ *
+ * Enabled with -D OC_WIDGET_BENCH in platformio.ini build_flags: main.cpp runs
+ * it at boot, before the contexts create their views, and logs EncoderBar
+ * against EncoderSlider.
+ */
+
+#include <Arduino.h>
+
+#include "ui/widget/EncoderBar.hpp"
+#include "ui/widget/EncoderSlider.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <lvgl.h>
+
+namespace debug {
+
+constexpr size_t WIDGET_BENCH_COUNT = 4;    ///< Widgets on screen (fits 240 px)
+constexpr size_t WIDGET_BENCH_STEPS = 256;  ///< Measured frames
+
+struct WidgetBenchResult {
+    uint32_t objects = 0;        ///< LVGL objects per widget
+    uint32_t invalidatedPx = 0;  ///< Per frame, sum of the invalidated areas
+    uint32_t meanRenderUs = 0;   ///< Per frame, every widget moved by one step
+    uint32_t maxRenderUs = 0;
+};
+
+namespace detail {
+inline uint32_t countObjects(lv_obj_t* obj) {
+    uint32_t count = 1;
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); ++i) {
+        count += countObjects(lv_obj_get_child(obj, int32_t(i)));
+    }
+    return count;
+}
+
+inline void onInvalidate(lv_event_t* e) {
+    auto* total = static_cast<uint64_t*>(lv_event_get_user_data(e));
+    *total += lv_area_get_size(static_cast<const lv_area_t*>(lv_event_get_param(e)));
+}
+}  // namespace detail
+
+template <typename Widget>
+WidgetBenchResult benchWidget(lv_display_t* display, size_t count = WIDGET_BENCH_COUNT,
+                              size_t steps = WIDGET_BENCH_STEPS) {
+    lv_obj_t* previous = lv_screen_active();
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_obj_set_style_pad_all(screen, 12, 0);
+    lv_obj_set_style_pad_row(screen, 12, 0);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_COLUMN);
+    lv_screen_load(screen);
+
+    std::vector<std::unique_ptr<Widget>> widgets;
+    for (size_t i = 0; i < count; ++i) widgets.push_back(std::make_unique<Widget>(screen, "Bench"));
+    lv_refr_now(display);  // Layout and first full render, not measured
+
+    WidgetBenchResult result;
+    result.objects = (detail::countObjects(screen) - 1) / uint32_t(count);
+
+    uint64_t totalUs = 0;
+    uint64_t invalidatedPx = 0;
+    lv_display_add_event_cb(display, detail::onInvalidate, LV_EVENT_INVALIDATE_AREA,
+                            &invalidatedPx);
+    for (size_t step = 1; step <= steps; ++step) {
+        const size_t phase = step % 128;
+        const float value = float(phase < 64 ? phase : 128 - phase) / 64.0f;
+        for (auto& widget : widgets) widget->setValue(value);
+
+        const uint32_t start = micros();
+        lv_refr_now(display);
+        const uint32_t renderUs = micros() - start;
+        totalUs += renderUs;
+        result.maxRenderUs = std::max(result.maxRenderUs, renderUs);
+    }
+    lv_display_remove_event_cb_with_user_data(display, detail::onInvalidate, &invalidatedPx);
+    result.meanRenderUs = uint32_t(totalUs / steps);
+    result.invalidatedPx = uint32_t(invalidatedPx / steps);
+
+    widgets.clear();
+    lv_screen_load(previous);
+    lv_obj_delete(screen);
+    return result;
+}
+
+}  // namespace debug
@@ -5,15 +5,47 @@
  * @brief Input handler with auto-generated MIDI bindings
  *
  * Auto-generates MIDI CC mappings from array indices:
- *   - Encoder[i] -> Config::Midi::ENC_CC_RANGE_START + i
+ *   - Encoder[i] -> Config::Midi::ENC_CC_RANGE_START + bank * ENCODER_COUNT + i,
+ *                   value from Config::Encoder::PARAMS[i]
  *   - Button[i]  -> Config::Midi::BTN_CC_RANGE_START + i
  *
  * Architecture:
- *   Config::Encoder::ALL  -->  Handler  -->  MIDI + View
+ *   Config::Encoder::ALL  -->  Handler  -->  MIDI + State  --(once per frame)-->  View
  *   Config::Button::ALL   -->  (auto)   -->  (callbacks)
+ *
+ * Handler never touches widgets: it writes the state model at input rate and
+ * the view syncs the latest dirty values right before each LVGL refresh.
+ *
+ * Button actions come from the gesture table (Config::Input::GESTURES), evaluated
+ * by update() once per app tick; button CCs are still sent on every press/release.
+ * Direct buttons (BUTTONS) come from framework callbacks; scanned buttons
+ * (Config::Button::Mux, Config::Button::Matrix) are polled in update() as debounced
+ * edge bitmasks.
+ *
+ * Encoders with the QUAD_DECODER backend (Config::Encoder::BACKENDS) are not known
+ * to the framework: update() reads their hardware counters (input::QuadDecoder) and
+ * feeds the same path as the framework's turn callbacks.
+ *
+ * Encoder banks (Config::Encoder::BANKS): selecting a bank switches the state's
+ * active bank (no copy) and moves the encoders to that bank's stored positions.
+ *
+ * On a context switch the outgoing context calls releaseButtons(): its held buttons
+ * and gesture progress are dropped, the incoming handler sees the physical releases.
  */
 
+#include <Arduino.h>
+
 #include "Config.hpp"
+#include "context/ContextSwitch.hpp"
+#include "input/GestureEngine.hpp"
+#include "input/MatrixScanner.hpp"
+#include "input/MuxScanner.hpp"
+#include "input/QuadDecoder.hpp"
+#include "model/ControlState.hpp"
+#include "model/Parameter.hpp"
+#include "power/Governor.hpp"
+
+#include <array>
 
 #include <oc/api/ButtonAPI.hpp>
 #include <oc/api/EncoderAPI.hpp>
@@ -25,93 +57,197 @@ namespace handler {
  * @brief Auto-binding input handler
  *
  * Iterates over Config::Encoder::ENCODERS and Config::Button::BUTTONS,
- * automatically generating MIDI CC bindings and view updates.
+ * automatically generating MIDI CC bindings and state updates.
  *
  * Uses two-phase initialization:
  * 1. Default construct as class member
  * 2. Call setup() in initialize() when APIs are available
  *
- * @tparam View Must implement:
- *   - static constexpr float DEFAULT_VALUE
- *   - void setButton(size_t index, bool pressed)
- *   - void setEncoder(size_t index, float value)
- *   - void resetEncoderPositions()
+ * @tparam State Must implement (see model::ControlState):
+ *   - static constexpr model::Position DEFAULT_POSITION
+ *   - void setButton(size_t index, bool pressed), bool button(size_t index) const
+ *   - void setEncoder(size_t index, model::Position position)
+ *   - void resetEncoders()
+ *   - model::Position encoder(size_t index) const
+ *   - static constexpr size_t BANK_COUNT, SLOT_COUNT
+ *   - bool setBank(size_t bank, uint32_t timeUs), size_t bank() const
  */
-template <typename View>
+template <typename State>
 class Handler {
 public:
     static constexpr size_t ENCODER_COUNT = Config::Encoder::ENCODERS.size();
-    static constexpr size_t BUTTON_COUNT = Config::Button::BUTTONS.size();
+    static constexpr size_t BUTTON_COUNT = Config::Button::COUNT;
+    static constexpr size_t DIRECT_BUTTON_COUNT = Config::Button::BUTTONS.size();
+    static constexpr size_t MUX_BUTTON_START = DIRECT_BUTTON_COUNT;
+    static constexpr size_t MATRIX_BUTTON_START = MUX_BUTTON_START + input::MuxScanner::BUTTONS;
 
     /// Default constructor - call setup() before use
     Handler() = default;
 
-    /// Initialize with APIs and view, auto-binds all inputs
+    /// CC number of an encoder in a bank (ENC_CC_RANGE_START + bank * ENCODER_COUNT + index)
+    static constexpr uint8_t encoderCC(size_t bank, size_t index) {
+        return uint8_t(Config::Midi::ENC_CC_RANGE_START + bank * ENCODER_COUNT + index);
+    }
+
+    /// State slot (bank * ENCODER_COUNT + index) of a CC number, or SLOT_COUNT if none
+    static constexpr size_t encoderSlot(uint8_t cc) {
+        const size_t offset = size_t(cc - Config::Midi::ENC_CC_RANGE_START);
+        return cc >= Config::Midi::ENC_CC_RANGE_START && offset < State::SLOT_COUNT
+                   ? offset
+                   : State::SLOT_COUNT;
+    }
+
+    /// Enable/disable MIDI output of an encoder (state is still updated), e.g. when a
+    /// Modulator sends its CC instead
+    void setEncoderOutput(size_t index, bool enabled) {
+        if (index < ENCODER_COUNT) outputMuted_[index] = !enabled;
+    }
+
+    /// Encoder `index` was turned within the last `ms` milliseconds (never before its
+    /// first turn, also in the first `ms` after boot)
+    bool touchedWithin(size_t index, uint32_t ms) const {
+        return touched_[index] && millis() - touchedMs_[index] < ms;
+    }
+
+    /// Initialize with APIs and state model, auto-binds all inputs
     void setup(oc::api::ButtonAPI& buttons, oc::api::EncoderAPI& encoders,
-               oc::api::MidiAPI& midi, View& view) {
+               oc::api::MidiAPI& midi, State& state) {
         buttons_ = &buttons;
         encoders_ = &encoders;
         midi_ = &midi;
-        view_ = &view;
+        state_ = &state;
         bind();
     }
 
+    /// Make `bank` the active encoder bank: O(1) in the state, encoders moved to its values
+    void selectBank(size_t bank) {
+        if (!state_->setBank(bank, micros())) return;
+        restorePositions();
+    }
+
+    /// Drop held buttons and gesture progress (context cleanup). No CC is sent: the
+    /// release goes to the next context's handler, on the same CC
+    void releaseButtons() {
+        for (size_t i = 0; i < BUTTON_COUNT; ++i) {
+            if (state_->button(i)) state_->setButton(i, false);
+        }
+        pressed_ = 0;
+        gestures_.reset();
+    }
+
+    /// Poll hardware-counted encoders and scanned buttons, evaluate button gestures
+    /// (call once per app tick)
+    void update() {
+        input::QuadDecoder::instance().poll(
+            [this](size_t index, model::Position raw) { onEncoder(index, raw); });
+        input::MuxScanner::instance().poll([this](const auto& edges) {
+            edges.forEach([this](size_t bit, bool pressed) {
+                setButton(MUX_BUTTON_START + bit, pressed);
+            });
+        });
+        input::MatrixScanner::instance().poll([this](const auto& edges) {
+            edges.forEach([this](size_t bit, bool pressed) {
+                setButton(MATRIX_BUTTON_START + bit, pressed);
+            });
+        });
+        gestures_.update(pressed_, millis(), [this](const Config::Input::GestureDef& gesture) {
+            onAction(gesture.action);
+        });
+    }
+
 private:
     oc::api::ButtonAPI* buttons_ = nullptr;
     oc::api::EncoderAPI* encoders_ = nullptr;
     oc::api::MidiAPI* midi_ = nullptr;
-    View* view_ = nullptr;
+    State* state_ = nullptr;
+    std::array<bool, ENCODER_COUNT> outputMuted_{};
+    std::array<uint32_t, ENCODER_COUNT> touchedMs_{};  ///< millis() of the last turn
+    std::array<bool, ENCODER_COUNT> touched_{};        ///< Turned at least once
+    Config::Input::ButtonMask pressed_ = 0;  ///< Bit i = button i held (first 64)
+    input::GestureEngine<Config::Input::GestureDef, Config::Input::GESTURES.size()> gestures_{
+        Config::Input::GESTURES, Config::Input::TIMING};
 
     void bind() {
+        restorePositions();
         bindEncoders();
         bindButtons();
     }
 
+    /// Encoders are shared by all contexts and banks: resume from the active bank's values
+    void restorePositions() {
+        for (size_t i = 0; i < ENCODER_COUNT; ++i) setEncoderPosition(i, state_->encoder(i));
+    }
+
+    void setEncoderPosition(size_t index, model::Position position) {
+        if (input::QuadDecoder::uses(index)) {
+            input::QuadDecoder::instance().setPosition(index, position);
+        } else {
+            encoders_->setPosition(Config::Encoder::ENCODERS[index].id,
+                                   model::toNormalized(position));
+        }
+    }
+
     // ═══════════════════════════════════════════════════════════════════
-    // Encoders: auto-bind ENCODERS[] -> MIDI CC + view
+    // Encoders: auto-bind ENCODERS[] -> parameter -> MIDI CC + state
     // ═══════════════════════════════════════════════════════════════════
 
     void bindEncoders() {
         for (size_t i = 0; i < ENCODER_COUNT; ++i) {
+            if (input::QuadDecoder::uses(i)) continue;  // Polled in update()
             encoders_->encoder(Config::Encoder::ENCODERS[i].id)
                 .turn()
                 .then([this, i](float value) {
-                    sendEncoderCC(i, value);
-                    view_->setEncoder(i, value);
+                    // Only float op of the event: framework value to fixed point
+                    onEncoder(i, model::toPosition(value));
                 });
         }
     }
 
-    void sendEncoderCC(size_t index, float value) {
+    void onEncoder(size_t index, model::Position raw) {
+        power::Governor::instance().activity();  // Full clock before the CC goes out
+        touchedMs_[index] = millis();
+        touched_[index] = true;
+        const auto param = model::ENCODER_PARAMETERS[index].apply(raw);
+        if (!outputMuted_[index]) sendEncoderCC(index, param.output);
+        state_->setEncoder(index, param.position);
+    }
+
+    void sendEncoderCC(size_t index, int32_t output) {
         midi_->sendCC(
             Config::Midi::CHANNEL,
-            Config::Midi::ENC_CC_RANGE_START + index,
-            uint8_t(value * 127)
+            encoderCC(state_->bank(), index),
+            uint8_t(output < 0 ? 0 : output > 127 ? 127 : output)
         );
     }
 
     // ═══════════════════════════════════════════════════════════════════
-    // Buttons: auto-bind BUTTONS[] -> MIDI CC + actions
+    // Buttons: auto-bind BUTTONS[] -> MIDI CC + gesture input
     // ═══════════════════════════════════════════════════════════════════
 
     void bindButtons() {
-        for (size_t i = 0; i < BUTTON_COUNT; ++i) {
+        for (size_t i = 0; i < DIRECT_BUTTON_COUNT; ++i) {
             auto id = Config::Button::BUTTONS[i].id;
 
             buttons_->button(id)
                 .press()
-                .then([this, i] {
-                    sendButtonCC(i, 127);
-                    view_->setButton(i, true);
-                    onButtonPress(i);
-                });
+                .then([this, i] { setButton(i, true); });
 
             buttons_->button(id)
                 .release()
-                .then([this, i] {
-                    sendButtonCC(i, 0);
-                    view_->setButton(i, false);
-                });
+                .then([this, i] { setButton(i, false); });
+        }
+    }
+
+    /// Press/release of any button (direct or scanned)
+    void setButton(size_t index, bool pressed) {
+        power::Governor::instance().activity();
+        sendButtonCC(index, pressed ? 127 : 0);
+        state_->setButton(index, pressed);
+        if (index >= 64) return;  // Beyond the gesture mask
+        if (pressed) {
+            pressed_ |= Config::Input::button(index);
+        } else {
+            pressed_ &= ~Config::Input::button(index);
         }
     }
 
@@ -123,17 +259,21 @@ private:
         );
     }
 
-    void onButtonPress(size_t index) {
-        if (index == 0) {
-            resetAllEncoders();
+    void onAction(Config::Input::Action action) {
+        using Action = Config::Input::Action;
+        switch (action) {
+            case Action::RESET_ENCODERS: resetAllEncoders(); break;
+            case Action::NEXT_CONTEXT:  // Applied by the main loop
+                context::Switch::request(context::Switch::next(context::Switch::active));
+                break;
+            case Action::NEXT_BANK: selectBank((state_->bank() + 1) % State::BANK_COUNT); break;
+            case Action::NONE: break;
         }
     }
 
     void resetAllEncoders() {
-        for (size_t i = 0; i < ENCODER_COUNT; ++i) {
-            encoders_->setPosition(Config::Encoder::ENCODERS[i].id, View::DEFAULT_VALUE);
-        }
-        view_->resetEncoderPositions();
+        for (size_t i = 0; i < ENCODER_COUNT; ++i) setEncoderPosition(i, State::DEFAULT_POSITION);
+        state_->resetEncoders();
     }
 };
 
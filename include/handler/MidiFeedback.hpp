@@ -0,0 +1,176 @@
+#pragma once
+
+/**
+ * @file MidiFeedback.hpp
+ * @brief Incoming MIDI feedback -> encoder positions + state model
+ *
+ * The reverse path of Handler, for contexts driven by a DAW:
+ *
+ *   USB-MIDI packets --> UsbMidiParser --> MidiFeedback --> State (dirty bits) --> View
+ *                                                      \--> encoder positions (flush)
+ *
+ * CCs are routed with Handler's own mapping (Handler::encoderSlot), so a DAW
+ * echoing the controller's CCs lands on the encoder and bank that sent them, at the
+ * position producing that value (Parameter::positionOf, curves included).
+ * Values of inactive banks are stored and shown when their bank is selected.
+ * Feedback is not re-sent as MIDI.
+ *
+ * While an encoder is turned, the DAW echoes each CC back a few ms later: applying
+ * the echo would pull the encoder back to an older value. CCs for an encoder of the
+ * active bank turned in the last Config::Midi::FEEDBACK_HOLDOFF_MS are dropped.
+ *
+ * Bursts are coalesced twice: the state keeps one dirty bit per encoder (one view
+ * sync per frame, whatever the burst size), and encoder positions are only written
+ * in flush(), once per encoder per poll.
+ *
+ * SysEx bulk transfer (layout in model/StateDump.hpp, framing in midi/SysEx.hpp):
+ *   - DUMP_REQUEST (no payload): reply with a DUMP of the whole state
+ *   - DUMP: restore every encoder/button at once (one view sync)
+ *
+ * Dumps are sent with usbMIDI directly: oc::api::MidiAPI only has channel messages
+ * (CC, notes, program change, pitch bend, pressure), no SysEx. Incoming MIDI also
+ * comes straight from usbMIDI (midi::UsbMidiInput), so both directions use the
+ * same USB port as the API.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "handler/Handler.hpp"
+#include "input/QuadDecoder.hpp"
+#include "midi/SysEx.hpp"
+#include "midi/UsbMidiParser.hpp"
+#include "model/ControlState.hpp"
+#include "model/Parameter.hpp"
+#include "model/StateDump.hpp"
+
+#include <array>
+
+#include <oc/api/EncoderAPI.hpp>
+
+namespace handler {
+
+/**
+ * @brief MIDI input sink updating the model and encoder positions
+ *
+ * Two-phase initialization like Handler: default construct, then setup().
+ *
+ * @tparam State See Handler (setSlot, encoder, bank), plus what model::StateDump needs
+ */
+template <typename State>
+class MidiFeedback : public midi::MidiSink {
+public:
+    static constexpr size_t ENCODER_COUNT = Handler<State>::ENCODER_COUNT;
+
+    using Dump = model::StateDump<State>;
+
+    enum SysExCommand : uint8_t {
+        DUMP_REQUEST = 0x01,
+        DUMP = 0x02,
+    };
+
+    struct Stats {
+        uint32_t received = 0;        ///< CCs routed to an encoder
+        uint32_t echoes = 0;          ///< CCs dropped: encoder turned within the holdoff
+        uint32_t positionWrites = 0;  ///< setPosition() calls after coalescing
+        uint32_t dumpsSent = 0;
+        uint32_t restores = 0;
+        uint32_t rejected = 0;        ///< SysEx dropped (checksum, framing, bad dump)
+    };
+
+    MidiFeedback() : decoder_(Config::Midi::SYSEX_MANUFACTURER, Config::Midi::SYSEX_DEVICE) {}
+
+    /// handler: the context's input handler, tells which encoders are being turned
+    void setup(oc::api::EncoderAPI& encoders, State& state, const Handler<State>& handler) {
+        encoders_ = &encoders;
+        state_ = &state;
+        handler_ = &handler;
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // MidiSink
+    // ═══════════════════════════════════════════════════════════════════
+
+    void onControlChange(uint8_t channel, uint8_t cc, uint16_t value14) {
+        if (channel != Config::Midi::CHANNEL) return;
+        const size_t slot = Handler<State>::encoderSlot(cc);
+        if (slot >= State::SLOT_COUNT) return;
+
+        const size_t index = slot % ENCODER_COUNT;
+        const bool active = slot / ENCODER_COUNT == state_->bank();
+        if (active && handler_->touchedWithin(index, Config::Midi::FEEDBACK_HOLDOFF_MS)) {
+            ++stats_.echoes;
+            return;
+        }
+        ++stats_.received;
+        const model::Parameter& param = model::ENCODER_PARAMETERS[index];
+        const int32_t span = param.max() - param.min();
+        const int32_t value = param.min() + (int32_t(value14) * span + midi::VALUE14_MAX / 2) /
+                                                midi::VALUE14_MAX;
+        state_->setSlot(slot, param.positionOf(value));
+        if (active) pendingPositions_.set(index);
+    }
+
+    void onSysEx(const uint8_t* data, uint8_t size, bool /*end*/) {
+        switch (decoder_.feed(data, size)) {
+            case Decoder::Result::COMPLETE: handleSysEx(); break;
+            case Decoder::Result::ERROR: ++stats_.rejected; break;
+            default: break;
+        }
+    }
+
+    /// Send the whole state as one SysEx DUMP
+    void sendDump() {
+        std::array<uint8_t, Dump::BYTES> payload;
+        const size_t size = Dump::write(*state_, payload.data());
+        const size_t length =
+            midi::sysex::encode(Config::Midi::SYSEX_MANUFACTURER, Config::Midi::SYSEX_DEVICE,
+                                DUMP, payload.data(), size, message_.data());
+        usbMIDI.sendSysEx(length, message_.data(), true);
+        usbMIDI.send_now();
+        ++stats_.dumpsSent;
+    }
+
+    /// Move encoders to the last received values (call after each poll)
+    void flush() {
+        pendingPositions_.consume([this](size_t i) {
+            ++stats_.positionWrites;
+            if (input::QuadDecoder::uses(i)) {
+                input::QuadDecoder::instance().setPosition(i, state_->encoder(i));
+            } else {
+                encoders_->setPosition(Config::Encoder::ENCODERS[i].id,
+                                       model::toNormalized(state_->encoder(i)));
+            }
+        });
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    using Decoder = midi::sysex::Decoder<Dump::BYTES>;
+
+    void handleSysEx() {
+        switch (decoder_.command()) {
+            case DUMP_REQUEST: sendDump(); break;
+            case DUMP:
+                if (!Dump::read(decoder_.payload(), decoder_.size(), *state_)) {
+                    ++stats_.rejected;
+                    return;
+                }
+                ++stats_.restores;
+                pendingPositions_.setAll();
+                break;
+            default: break;
+        }
+    }
+
+    oc::api::EncoderAPI* encoders_ = nullptr;
+    State* state_ = nullptr;
+    const Handler<State>* handler_ = nullptr;
+    model::DirtyBits<ENCODER_COUNT> pendingPositions_;
+    Decoder decoder_;
+    std::array<uint8_t, midi::sysex::messageSize(Dump::BYTES)> message_{};
+    Stats stats_;
+};
+
+}  // namespace handler
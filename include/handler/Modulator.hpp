@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file Modulator.hpp
+ * @brief Tempo-locked LFO/step modulation of encoder CC output
+ *
+ * Runs on the app tick (update(), non-blocking): for each Config::Modulation::LFOS
+ * entry, position = encoder position (from the state model) + depth * shape(phase),
+ * then the encoder's parameter mapping gives the CC. The phase is taken from
+ * ClockSync at the current time. A CC is sent only when its 7-bit value changes,
+ * so the output rate follows the modulation slope.
+ *
+ * Modulated encoders are owned by the Modulator: their Handler output is muted,
+ * and turning them moves the center of the modulation. Without a running clock
+ * the plain encoder value is sent. An LFO follows its encoder across banks: it
+ * modulates the CC of the active bank.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "handler/Handler.hpp"
+#include "midi/ClockSync.hpp"
+#include "model/ControlState.hpp"
+#include "model/Parameter.hpp"
+
+#include <array>
+#include <cmath>
+
+#include <oc/api/MidiAPI.hpp>
+
+namespace handler {
+
+/**
+ * @brief Applies Config::Modulation::LFOS to encoder CCs
+ *
+ * Two-phase initialization like Handler: default construct, then setup().
+ *
+ * @tparam State See Handler (encoder, bank)
+ */
+template <typename State>
+class Modulator {
+public:
+    using Lfo = Config::Modulation::LfoDef;
+    using Shape = Config::Modulation::Shape;
+    static constexpr size_t LFO_COUNT = Config::Modulation::LFOS.size();
+
+    struct Stats {
+        uint32_t sent = 0;          ///< CCs sent after change filtering
+        uint32_t lastUpdateUs = 0;  ///< Cost of the last update()
+    };
+
+    Modulator() { lastSent_.fill(NONE); }
+
+    /// Take over the modulated encoders' output from handler
+    void setup(oc::api::MidiAPI& midi, const State& state, const midi::ClockSync& clock,
+               Handler<State>& handler) {
+        midi_ = &midi;
+        state_ = &state;
+        clock_ = &clock;
+        for (const Lfo& lfo : Config::Modulation::LFOS) {
+            handler.setEncoderOutput(lfo.encoder, false);
+        }
+        lastSent_.fill(NONE);
+    }
+
+    /// Compute and send modulated values for the current time (call every app tick)
+    void update() {
+        const uint32_t now = micros();
+        const bool running = clock_->running(now);
+        const double beats = running ? clock_->beats(now) : 0.0;
+        const size_t bank = state_->bank();
+        if (bank != bank_) {  // New CC numbers: resend
+            bank_ = bank;
+            lastSent_.fill(NONE);
+        }
+
+        for (size_t i = 0; i < LFO_COUNT; ++i) {
+            const Lfo& lfo = Config::Modulation::LFOS[i];
+            int32_t position = state_->encoder(lfo.encoder);
+            if (running) {
+                const float offset = lfo.depth * shape(lfo, phase(beats, lfo.beats));
+                position += int32_t(offset * model::POSITION_MAX);
+                position = position < 0 ? 0 : position > model::POSITION_MAX ? model::POSITION_MAX
+                                                                              : position;
+            }
+
+            // Same mapping as Handler (curve, range, step)
+            const int32_t output = model::ENCODER_PARAMETERS[lfo.encoder].output(position);
+            const uint8_t cc = uint8_t(output < 0 ? 0 : output > 127 ? 127 : output);
+            if (cc == lastSent_[i]) continue;
+            lastSent_[i] = cc;
+            midi_->sendCC(Config::Midi::CHANNEL, Handler<State>::encoderCC(bank, lfo.encoder),
+                          cc);
+            ++stats_.sent;
+        }
+        stats_.lastUpdateUs = micros() - now;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+    /// Bipolar shape value (-1..1) at phase (0..1)
+    static float shape(const Lfo& lfo, float phase) {
+        switch (lfo.shape) {
+            case Shape::SINE: return std::sin(6.2831853f * phase);
+            case Shape::TRIANGLE: return 1.0f - 4.0f * std::fabs(phase - 0.5f);
+            case Shape::SAW: return 2.0f * phase - 1.0f;
+            case Shape::SQUARE: return phase < 0.5f ? 1.0f : -1.0f;
+            case Shape::STEPS: return lfo.steps[size_t(phase * 8) & 7] / 100.0f;
+        }
+        return 0.0f;
+    }
+
+private:
+    static constexpr uint8_t NONE = 0xFF;
+
+    static float phase(double beats, uint8_t beatsPerCycle) {
+        const double cycles = beats / beatsPerCycle;
+        return float(cycles - std::floor(cycles));
+    }
+
+    oc::api::MidiAPI* midi_ = nullptr;
+    const State* state_ = nullptr;
+    const midi::ClockSync* clock_ = nullptr;
+    std::array<uint8_t, LFO_COUNT> lastSent_{};
+    size_t bank_ = 0;
+    Stats stats_;
+};
+
+}  // namespace handler
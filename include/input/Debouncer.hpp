@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file Debouncer.hpp
+ * @brief Debouncing of packed button frames into press/release edge bitmasks
+ *
+ * Scanned buttons (see MuxScanner) arrive as frames: one bit per button, 32 per
+ * word, 1 = pressed (raw, bouncing). A debouncer turns each frame into Edges:
+ * the buttons whose debounced state changed, as two bitmasks walked with
+ * count-trailing-zeros, so the consumer's cost follows activity, not button count.
+ *
+ * A change must last `frames` consecutive frames. VerticalDebouncer has no per-button
+ * branch (32 buttons per word); test/test_debouncer checks it against a per-button
+ * counter model and benchmarks both from 8 to 256 buttons.
+ *
+ * No Arduino dependency: builds on a host.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace input {
+
+/// N bits packed 32 per word, bit i = button i
+template <size_t N>
+using BitWords = std::array<uint32_t, (N + 31) / 32>;
+
+/// Debounced state changes of one frame
+template <size_t N>
+struct Edges {
+    BitWords<N> pressed{};
+    BitWords<N> released{};
+
+    bool any() const {
+        for (size_t w = 0; w < pressed.size(); ++w) {
+            if (pressed[w] | released[w]) return true;
+        }
+        return false;
+    }
+
+    /// fn(index, pressed) for each edge, in index order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < pressed.size(); ++w) {
+            uint32_t bits = pressed[w] | released[w];
+            while (bits) {
+                const size_t bit = size_t(__builtin_ctz(bits));
+                fn(w * 32 + bit, bool((pressed[w] >> bit) & 1));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+/// Counter planes needed to count up to `frames`
+constexpr size_t counterBits(uint32_t frames) {
+    size_t bits = 1;
+    while (bits < 32 && (frames >> bits) != 0) ++bits;
+    return bits;
+}
+
+/**
+ * @brief Bit-parallel debouncer with vertical counters
+ *
+ * Each button has a Bits-bit counter stored vertically: plane k holds bit k of the
+ * counters of 32 buttons in one word. A frame costs, per word, one ripple
+ * increment over the planes (counting where raw differs from the debounced state,
+ * cleared where it agrees) and one compare with `frames`; words with no difference
+ * and no count in progress are skipped.
+ *
+ * @tparam N    Number of buttons
+ * @tparam Bits Counter width (counterBits(frames))
+ */
+template <size_t N, size_t Bits = 4>
+class VerticalDebouncer {
+public:
+    static constexpr uint32_t MAX_FRAMES = (1u << Bits) - 1;
+
+    /// @param frames Consecutive frames a change must last (1-MAX_FRAMES)
+    explicit VerticalDebouncer(uint32_t frames) {
+        frames = frames == 0 ? 1 : frames > MAX_FRAMES ? MAX_FRAMES : frames;
+        for (size_t k = 0; k < Bits; ++k) target_[k] = (frames >> k) & 1 ? ~0u : 0u;
+    }
+
+    /// Feed one raw frame, return the debounced edges
+    Edges<N> update(const BitWords<N>& raw) {
+        Edges<N> edges;
+        for (size_t w = 0; w < raw.size(); ++w) {
+            const uint32_t differ = raw[w] ^ state_[w];
+            if (!(differ | counting_[w])) continue;
+
+            // counter = differ ? counter + 1 : 0
+            uint32_t carry = differ;
+            uint32_t reached = differ;
+            for (size_t k = 0; k < Bits; ++k) {
+                const uint32_t plane = planes_[k][w];
+                const uint32_t next = (plane ^ carry) & differ;
+                carry &= plane;
+                planes_[k][w] = next;
+                reached &= ~(next ^ target_[k]);  // Counter bit k == bit k of frames
+            }
+            counting_[w] = differ & ~reached;
+
+            if (!reached) continue;
+            for (size_t k = 0; k < Bits; ++k) planes_[k][w] &= ~reached;
+            state_[w] ^= reached;
+            edges.pressed[w] = reached & raw[w];
+            edges.released[w] = reached & ~raw[w];
+        }
+        return edges;
+    }
+
+    /// Debounced state, bit i = button i pressed
+    const BitWords<N>& state() const { return state_; }
+
+private:
+    std::array<uint32_t, Bits> target_{};  ///< Bit k of `frames`, broadcast to a word
+    std::array<BitWords<N>, Bits> planes_{};
+    BitWords<N> state_{};
+    BitWords<N> counting_{};  ///< Non-zero counters
+};
+
+}  // namespace input
@@ -0,0 +1,252 @@
+#pragma once
+
+/**
+ * @file GestureEngine.hpp
+ * @brief Table-driven button gestures over a packed button-state bitmask
+ *
+ * Input: one bitmask of pressed buttons (bit i = Handler button i) and the time, once
+ * per app tick. Output: the GestureDef rows that triggered, in table order.
+ *
+ * Each tick is a single pass over the gesture table with mask tests only
+ * (chord = all bits of the row down, edge = state differs from the previous
+ * tick); rows of other layers are skipped, and an idle panel (nothing held,
+ * nothing pending) returns immediately.
+ *
+ * Interactions:
+ *   - A button is "consumed" once it took part in a LONG_PRESS, HOLD_REPEAT,
+ *     CHORD or SHIFT: it triggers no TAP/DOUBLE_TAP until released.
+ *   - TAP and DOUBLE_TAP on the same buttons/layer share one detector: a single
+ *     tap is reported after the double-tap window, a double tap replaces it.
+ *
+ * No Arduino or Config dependency: builds on a host (test/test_gestures). The table
+ * rows (Config::Input::GestureDef) and timings (Config::Input::TIMING) are passed in.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace input {
+
+using ButtonMask = uint64_t;  // Gestures: first 64 buttons
+constexpr ButtonMask button(size_t index) { return ButtonMask(1) << index; }
+
+enum class Gesture : uint8_t { PRESS, TAP, DOUBLE_TAP, LONG_PRESS, HOLD_REPEAT, CHORD, SHIFT };
+
+struct GestureTiming {
+    uint32_t longPressMs;   ///< LONG_PRESS / HOLD_REPEAT start, TAP must be shorter
+    uint32_t doubleTapMs;   ///< Second tap window, after the first release
+    uint32_t holdRepeatMs;  ///< HOLD_REPEAT period
+};
+
+/**
+ * @tparam Def  Table row: { Gesture gesture; ButtonMask buttons; uint8_t layer; ... }
+ * @tparam Rows Gesture table size (Config::Input::GESTURES.size())
+ */
+template <typename Def, size_t Rows>
+class GestureEngine {
+public:
+    using GestureDef = Def;
+
+    struct Stats {
+        uint32_t ticks = 0;
+        uint32_t idleTicks = 0;  ///< Early-out: nothing held or pending
+        uint32_t fired = 0;
+    };
+
+    constexpr GestureEngine(const std::array<GestureDef, Rows>& table, GestureTiming timing)
+        : table_(table),
+          timing_(timing),
+          partner_(findPartners(table)),
+          shiftMask_(maskOf(table, Gesture::SHIFT)) {}
+
+    /// Evaluate one tick; fn(const GestureDef&) for each triggered gesture
+    template <typename Fn>
+    void update(ButtonMask pressed, uint32_t nowMs, Fn&& fn) {
+        ++stats_.ticks;
+        const ButtonMask previous = previous_;
+        if ((pressed | previous) == 0 && pendingTaps_ == 0) {
+            ++stats_.idleTicks;
+            return;
+        }
+
+        layer_ = activeLayer(pressed);
+        consumed_ |= pressed & shiftMask_;
+
+        for (size_t i = 0; i < Rows; ++i) {
+            const GestureDef& row = table_[i];
+            RowState& state = rows_[i];
+            const bool down = (pressed & row.buttons) == row.buttons;
+            const bool wasDown = (previous & row.buttons) == row.buttons;
+
+            if (row.layer != layer_ || row.gesture == Gesture::SHIFT) {
+                state.active = false;
+                continue;
+            }
+            if (down && !wasDown) {
+                state.startMs = nowMs;
+                state.active = true;
+                state.fired = false;
+            }
+
+            switch (row.gesture) {
+                case Gesture::PRESS:
+                    if (down && !wasDown) fire(row, fn);
+                    break;
+
+                case Gesture::CHORD:
+                    if (down && !wasDown) {
+                        consumed_ |= row.buttons;
+                        fire(row, fn);
+                    }
+                    break;
+
+                case Gesture::LONG_PRESS:
+                case Gesture::HOLD_REPEAT:
+                    if (!down || !state.active || (consumed_ & row.buttons & ~state.owned)) break;
+                    if (!state.fired && nowMs - state.startMs >= timing_.longPressMs) {
+                        state.fired = true;
+                        state.owned = row.buttons;
+                        state.nextMs = nowMs + timing_.holdRepeatMs;
+                        consumed_ |= row.buttons;
+                        fire(row, fn);
+                    } else if (state.fired && row.gesture == Gesture::HOLD_REPEAT &&
+                               int32_t(nowMs - state.nextMs) >= 0) {
+                        state.nextMs += timing_.holdRepeatMs;
+                        fire(row, fn);
+                    }
+                    break;
+
+                case Gesture::TAP:
+                case Gesture::DOUBLE_TAP: tap(i, down, wasDown, nowMs, fn); break;
+
+                case Gesture::SHIFT: break;
+            }
+            if (!down) state.owned = 0;
+        }
+
+        consumed_ &= pressed;  // Released buttons can tap again
+        previous_ = pressed;
+    }
+
+    /// Forget held buttons, pending taps and consumed buttons (context switch): nothing
+    /// fires for them, buttons still down count as new presses at the next update()
+    void reset() {
+        rows_ = {};
+        previous_ = 0;
+        consumed_ = 0;
+        pendingTaps_ = 0;
+        layer_ = 0;
+    }
+
+    uint8_t layer() const { return layer_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    static constexpr size_t NONE = Rows;
+
+    struct RowState {
+        uint32_t startMs = 0;  ///< Buttons all down since
+        uint32_t nextMs = 0;   ///< Next HOLD_REPEAT / tap window end
+        ButtonMask owned = 0;  ///< Buttons this row consumed itself
+        bool active = false;   ///< Went down in this row's layer
+        bool fired = false;
+        bool pending = false;  ///< First tap seen, waiting for a second one
+    };
+
+    /// TAP / DOUBLE_TAP detector (state kept on the DOUBLE_TAP row if there is one)
+    template <typename Fn>
+    void tap(size_t i, bool down, bool wasDown, uint32_t nowMs, Fn&& fn) {
+        const GestureDef& row = table_[i];
+        const size_t partner = partner_[i];
+        if (row.gesture == Gesture::TAP && partner != NONE) return;  // Handled by the partner
+
+        RowState& state = rows_[i];
+
+        // Window expired without a second press: it was a single tap
+        if (state.pending && !down && int32_t(nowMs - state.nextMs) >= 0) {
+            setPending(state, false);
+            if (partner != NONE) fire(table_[partner], fn);
+        }
+
+        const bool released = wasDown && !down;
+        if (!released || !state.active) return;
+        if ((consumed_ & row.buttons) || nowMs - state.startMs >= timing_.longPressMs) {
+            setPending(state, false);  // Second press became a long press/chord
+            return;
+        }
+
+        if (row.gesture == Gesture::TAP) {
+            fire(row, fn);
+        } else if (state.pending) {
+            setPending(state, false);
+            fire(row, fn);
+        } else {
+            setPending(state, true);
+            state.nextMs = nowMs + timing_.doubleTapMs;
+        }
+    }
+
+    void setPending(RowState& state, bool pending) {
+        if (state.pending == pending) return;
+        state.pending = pending;
+        pending ? ++pendingTaps_ : --pendingTaps_;
+    }
+
+    template <typename Fn>
+    void fire(const GestureDef& row, Fn&& fn) {
+        ++stats_.fired;
+        fn(row);
+    }
+
+    uint8_t activeLayer(ButtonMask pressed) const {
+        if ((pressed & shiftMask_) == 0) return 0;
+        for (const GestureDef& row : table_) {
+            if (row.gesture == Gesture::SHIFT && (pressed & row.buttons) == row.buttons) {
+                return row.layer;
+            }
+        }
+        return 0;
+    }
+
+    static constexpr ButtonMask maskOf(const std::array<GestureDef, Rows>& table, Gesture g) {
+        ButtonMask mask = 0;
+        for (const GestureDef& row : table) {
+            if (row.gesture == g) mask |= row.buttons;
+        }
+        return mask;
+    }
+
+    /// TAP row <-> DOUBLE_TAP row with the same buttons and layer
+    static constexpr std::array<size_t, Rows> findPartners(
+        const std::array<GestureDef, Rows>& table) {
+        std::array<size_t, Rows> partners{};
+        for (size_t i = 0; i < Rows; ++i) {
+            partners[i] = NONE;
+            for (size_t j = 0; j < Rows; ++j) {
+                const bool pair = (table[i].gesture == Gesture::TAP &&
+                                   table[j].gesture == Gesture::DOUBLE_TAP) ||
+                                  (table[i].gesture == Gesture::DOUBLE_TAP &&
+                                   table[j].gesture == Gesture::TAP);
+                if (pair && table[i].buttons == table[j].buttons &&
+                    table[i].layer == table[j].layer) {
+                    partners[i] = j;
+                }
+            }
+        }
+        return partners;
+    }
+
+    const std::array<GestureDef, Rows>& table_;
+    GestureTiming timing_;
+    std::array<size_t, Rows> partner_;
+    ButtonMask shiftMask_;
+    std::array<RowState, Rows> rows_{};
+    ButtonMask previous_ = 0;
+    ButtonMask consumed_ = 0;
+    uint32_t pendingTaps_ = 0;  ///< Rows waiting for a second tap
+    uint8_t layer_ = 0;
+    Stats stats_;
+};
+
+}  // namespace input
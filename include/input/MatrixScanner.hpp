@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file MatrixScanner.hpp
+ * @brief Background scanning of a key matrix, with ghost detection, into debounced edges
+ *
+ * Same pipeline as MuxScanner (ScanQueue): a timer ISR every
+ * Config::Button::Matrix::STEP_US reads the columns of the row driven at the
+ * previous step, then drives the next row. A frame is complete after ROWS steps,
+ * so the scan rate is set by STEP_US and the row count, not by APP_HZ.
+ *
+ * Rows are open drain: the driven row is an output held low, the others are
+ * released (input, high impedance) by toggling their direction bit, so pressed
+ * keys never short two driven rows. Columns use pull-ups: low = key closed.
+ * The direction registers are read-modify-written from the ISR, so do not
+ * reconfigure other pins of the row ports while scanning.
+ *
+ * Ghosting (matrix without diodes): three closed keys on the corners of a
+ * rectangle connect the fourth corner, which reads as closed. Any ghost shows as
+ * two rows sharing at least two columns; while a frame has such rows, they keep
+ * their last accepted state (no edges from them) until the ambiguity clears.
+ * test/test_matrix checks this on a simulated matrix without diodes: every 3-key L
+ * is held, legal chords pass unchanged, no ghost key ever reaches a frame.
+ *
+ * Worst-case timing, 8x8 with the defaults (STEP_US = 50, DEBOUNCE_MS = 5): a scan
+ * takes ROWS * STEP_US = 400 us, so a clean press gives its edge after at most
+ * (DEBOUNCE_FRAMES + 1) = 13 scans = 5.2 ms, plus one app tick. ISR cost with all
+ * 64 keys down (every row pair through the ghost check): about 51 ns per scan, 21 ns
+ * without the check, measured on the host by test_matrix; not measured on the target.
+ *
+ * Frame bit / button: row * COLS + col.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "input/Debouncer.hpp"
+#include "input/MatrixSequencer.hpp"
+#include "input/ScanQueue.hpp"
+
+#include <array>
+
+namespace input {
+
+class MatrixScanner {
+public:
+    static constexpr size_t ROWS = Config::Button::Matrix::ROW_PINS.size();
+    static constexpr size_t COLS = Config::Button::Matrix::COL_PINS.size();
+    using Sequencer = MatrixSequencer<ROWS, COLS>;
+    static constexpr size_t BUTTONS = Sequencer::BUTTONS;
+
+    /// Frame period and debounce length in frames (0 counts as 1)
+    static constexpr uint32_t FRAME_US = Config::Button::Matrix::STEP_US * (ROWS ? ROWS : 1);
+    static constexpr uint32_t DEBOUNCE_FRAMES = Config::Timing::DEBOUNCE_MS * 1000 / FRAME_US;
+
+    using Queue = ScanQueue<BUTTONS, Config::Button::Matrix::FRAME_QUEUE, DEBOUNCE_FRAMES>;
+    using Frame = Sequencer::Frame;
+    using Stats = Queue::Stats;
+
+    static MatrixScanner& instance() {
+        static MatrixScanner scanner;
+        return scanner;
+    }
+
+    /// Configure pins and start scanning (no-op without a matrix)
+    void begin() {
+        if (BUTTONS == 0) return;
+        for (size_t r = 0; r < ROWS; ++r) {
+            const uint8_t pin = Config::Button::Matrix::ROW_PINS[r];
+            pinMode(pin, OUTPUT);
+            digitalWrite(pin, LOW);  // Kept low: only the direction changes
+            rows_[r] = {portModeRegister(pin), digitalPinToBitMask(pin)};
+            release(r);
+        }
+        for (size_t c = 0; c < COLS; ++c) {
+            const uint8_t pin = Config::Button::Matrix::COL_PINS[c];
+            pinMode(pin, INPUT_PULLUP);
+            cols_[c] = {portInputRegister(pin), digitalPinToBitMask(pin)};
+        }
+        drive(sequencer_.row());
+        timer_.begin(onStep, Config::Button::Matrix::STEP_US);
+        timer_.priority(Config::Button::Matrix::SCAN_PRIORITY);
+    }
+
+    void end() {
+        timer_.end();
+        if (BUTTONS) release(sequencer_.row());
+    }
+
+    /// Debounce queued frames, fn(const Edges<BUTTONS>&) for each frame with edges
+    template <typename Fn>
+    size_t poll(Fn&& fn) {
+        return BUTTONS == 0 ? 0 : queue_.poll(fn);
+    }
+
+    /// Debounced state, bit row * COLS + col
+    const Frame& state() const { return queue_.state(); }
+    const Stats& stats() const { return queue_.stats(); }
+    uint32_t ghostFrames() const { return sequencer_.ghostFrames(); }
+
+private:
+    struct Pin {
+        volatile uint32_t* reg;  ///< Direction (rows) or input (columns) register
+        uint32_t mask;
+    };
+
+    MatrixScanner() : sequencer_(!Config::Button::Matrix::DIODES) {}
+
+    static void onStep() { instance().step(); }
+
+    /// ISR: read the settled row, drive the next one
+    void step() {
+        uint32_t columns = 0;
+        for (size_t c = 0; c < COLS; ++c) {
+            columns |= uint32_t(!(*cols_[c].reg & cols_[c].mask)) << c;
+        }
+        release(sequencer_.row());
+        const bool complete = sequencer_.sample(columns);
+        drive(sequencer_.row());
+        if (complete) queue_.push(sequencer_.frame());
+    }
+
+    void drive(size_t row) { *rows_[row].reg |= rows_[row].mask; }     // Output, low
+    void release(size_t row) { *rows_[row].reg &= ~rows_[row].mask; }  // Input, high-Z
+
+    IntervalTimer timer_;
+    std::array<Pin, ROWS> rows_{};
+    std::array<Pin, COLS> cols_{};
+    Sequencer sequencer_;
+    Queue queue_;
+};
+
+}  // namespace input
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file MatrixSequencer.hpp
+ * @brief Row sequence, frame assembly and ghost filtering of input::MatrixScanner
+ *
+ * No Arduino or Config dependency: builds on a host (test/test_matrix).
+ */
+
+#include "input/Debouncer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace input {
+
+/**
+ * @brief Steps through the rows, assembles frames and holds rows that may show ghosts
+ *
+ * @tparam Rows Driven lines (up to 32)
+ * @tparam Cols Read lines (up to 32)
+ */
+template <size_t Rows, size_t Cols>
+class MatrixSequencer {
+public:
+    static constexpr size_t BUTTONS = Rows * Cols;
+    using Frame = BitWords<BUTTONS>;
+    using RowBits = std::array<uint32_t, Rows>;
+
+    static_assert(Rows <= 32 && Cols <= 32, "One bit per row/column in a 32-bit word");
+
+    /// @param detectGhosts false for matrices with diodes (no ghosting possible)
+    explicit MatrixSequencer(bool detectGhosts = true) : detectGhosts_(detectGhosts) {}
+
+    /// Row to drive now
+    size_t row() const { return row_; }
+
+    /// Record the driven row's columns (bit c = key closed) and advance;
+    /// true when a frame was completed (see frame())
+    bool sample(uint32_t columns) {
+        rows_[row_] = columns;
+        if (++row_ < Rows) return false;
+        row_ = 0;
+
+        const uint32_t ghosts = detectGhosts_ ? ghostRows(rows_) : 0;
+        if (ghosts) ++ghostFrames_;
+
+        frame_ = Frame{};
+        for (size_t r = 0; r < Rows; ++r) {
+            const uint32_t bits = (ghosts >> r) & 1 ? accepted_[r] : rows_[r];
+            accepted_[r] = bits;
+            if (bits) place(r, bits);
+        }
+        return true;
+    }
+
+    const Frame& frame() const { return frame_; }
+
+    /// Frames in which some rows were held because of possible ghosts
+    uint32_t ghostFrames() const { return ghostFrames_; }
+
+    /// Rows (bit r) sharing two or more closed columns with another row
+    static uint32_t ghostRows(const RowBits& rows) {
+        uint32_t ghosts = 0;
+        for (size_t i = 0; i < Rows; ++i) {
+            if (!(rows[i] & (rows[i] - 1))) continue;  // Fewer than two keys in row i
+            for (size_t j = i + 1; j < Rows; ++j) {
+                const uint32_t shared = rows[i] & rows[j];
+                if (shared & (shared - 1)) ghosts |= (1u << i) | (1u << j);
+            }
+        }
+        return ghosts;
+    }
+
+private:
+    void place(size_t row, uint32_t bits) {
+        const size_t bit = row * Cols;
+        const size_t shift = bit & 31;
+        frame_[bit >> 5] |= bits << shift;
+        if (shift + Cols > 32) frame_[(bit >> 5) + 1] |= bits >> (32 - shift);
+    }
+
+    RowBits rows_{};      ///< Raw columns of the frame being scanned
+    RowBits accepted_{};  ///< Columns last put in a frame
+    Frame frame_{};
+    size_t row_ = 0;
+    uint32_t ghostFrames_ = 0;
+    bool detectGhosts_;
+};
+
+}  // namespace input
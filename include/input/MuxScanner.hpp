@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file MuxScanner.hpp
+ * @brief Background scanning of multiplexed buttons (74HC4067) into debounced edges
+ *
+ * Two stages, like UsbMidiInput (queue and debounce in ScanQueue):
+ *   - scan (IntervalTimer ISR every Config::Button::Mux::STEP_US): samples the signal
+ *     pin of every mux for the channel addressed at the previous step, then drives
+ *     the next address. The step period is the settle time of the address change.
+ *     After 16 steps the frame (one bit per button) is queued in a ring.
+ *   - poll (app update): debounces queued frames and hands out press/release edges.
+ *
+ * The app tick never waits for a mux to settle. Its cost is the debounce of
+ * ~APP period / FRAME_US frames, a few bit operations per word of 32 buttons
+ * (VerticalDebouncer). Host figures for 4 muxes (test_mux benchmark, -O2): 4 ns per
+ * ISR step, 11 ns of debounce per app tick at the Config defaults.
+ *
+ * Channels are visited in Gray code order: one address line toggles per step,
+ * so no intermediate address is glitched onto the bus. The address sequence and
+ * frame assembly (MuxSequencer) have no hardware access and are simulated on the
+ * host with settle delays by test_mux.
+ *
+ * Frame bit / button: mux * 16 + channel (index BUTTONS.size() + bit in Handler).
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "input/Debouncer.hpp"
+#include "input/MuxSequencer.hpp"
+#include "input/ScanQueue.hpp"
+
+#include <array>
+
+namespace input {
+
+class MuxScanner {
+public:
+    static constexpr size_t MUXES = Config::Button::Mux::SIGNAL_PINS.size();
+    using Sequencer = MuxSequencer<MUXES>;
+    static constexpr size_t BUTTONS = Sequencer::BUTTONS;
+
+    /// Frame period and debounce length in frames (0 counts as 1)
+    static constexpr uint32_t FRAME_US = Config::Button::Mux::STEP_US * Sequencer::CHANNELS;
+    static constexpr uint32_t DEBOUNCE_FRAMES = Config::Timing::DEBOUNCE_MS * 1000 / FRAME_US;
+
+    using Queue = ScanQueue<BUTTONS, Config::Button::Mux::FRAME_QUEUE, DEBOUNCE_FRAMES>;
+    using Frame = Sequencer::Frame;
+    using Stats = Queue::Stats;
+
+    static MuxScanner& instance() {
+        static MuxScanner scanner;
+        return scanner;
+    }
+
+    /// Configure pins and start scanning (no-op without muxes)
+    void begin() {
+        if (MUXES == 0) return;
+        for (size_t a = 0; a < ADDRESS_BITS; ++a) {
+            const uint8_t pin = Config::Button::Mux::ADDRESS_PINS[a];
+            pinMode(pin, OUTPUT);
+            address_[a] = {portSetRegister(pin), portClearRegister(pin), digitalPinToBitMask(pin)};
+        }
+        for (size_t m = 0; m < MUXES; ++m) {
+            const uint8_t pin = Config::Button::Mux::SIGNAL_PINS[m];
+            pinMode(pin, Config::Button::Mux::ACTIVE_LOW ? INPUT_PULLUP : INPUT_PULLDOWN);
+            signal_[m] = {portInputRegister(pin), digitalPinToBitMask(pin)};
+        }
+        drive(sequencer_.channel());
+        timer_.begin(onStep, Config::Button::Mux::STEP_US);
+        timer_.priority(Config::Button::Mux::SCAN_PRIORITY);
+    }
+
+    void end() { timer_.end(); }
+
+    /// Debounce queued frames, fn(const Edges<BUTTONS>&) for each frame with edges
+    template <typename Fn>
+    size_t poll(Fn&& fn) {
+        return MUXES == 0 ? 0 : queue_.poll(fn);
+    }
+
+    /// Debounced state, bit mux * 16 + channel
+    const Frame& state() const { return queue_.state(); }
+    const Stats& stats() const { return queue_.stats(); }
+
+private:
+    static constexpr size_t ADDRESS_BITS = 4;
+    static_assert(Config::Button::Mux::ADDRESS_PINS.size() == ADDRESS_BITS,
+                  "74HC4067: 4 address lines (S0-S3)");
+
+    struct OutputPin {
+        volatile uint32_t* set;
+        volatile uint32_t* clear;
+        uint32_t mask;
+    };
+    struct InputPin {
+        volatile uint32_t* input;
+        uint32_t mask;
+    };
+
+    MuxScanner() = default;
+
+    static void onStep() { instance().step(); }
+
+    /// ISR: sample the settled channel, address the next one
+    void step() {
+        uint32_t levels = 0;
+        for (size_t m = 0; m < MUXES; ++m) {
+            const bool high = *signal_[m].input & signal_[m].mask;
+            levels |= uint32_t(high != Config::Button::Mux::ACTIVE_LOW) << m;
+        }
+        const bool complete = sequencer_.sample(levels);
+        drive(sequencer_.channel());
+        if (complete) queue_.push(sequencer_.frame());
+    }
+
+    void drive(uint8_t channel) {
+        for (size_t a = 0; a < ADDRESS_BITS; ++a) {
+            *((channel >> a) & 1 ? address_[a].set : address_[a].clear) = address_[a].mask;
+        }
+    }
+
+    IntervalTimer timer_;
+    std::array<OutputPin, ADDRESS_BITS> address_{};
+    std::array<InputPin, MUXES> signal_{};
+    Sequencer sequencer_;
+    Queue queue_;
+};
+
+}  // namespace input
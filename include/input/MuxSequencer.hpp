@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * @file MuxSequencer.hpp
+ * @brief Address sequence and frame assembly of input::MuxScanner (no hardware access)
+ *
+ * No Arduino or Config dependency: builds on a host (test/test_mux).
+ */
+
+#include "input/Debouncer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace input {
+
+/**
+ * @brief Gray-code channel sequence; one frame (bit mux * 16 + channel) per 16 samples
+ *
+ * @tparam Muxes Number of 16-channel muxes sharing the address lines
+ */
+template <size_t Muxes>
+class MuxSequencer {
+public:
+    static constexpr size_t CHANNELS = 16;
+    static constexpr size_t BUTTONS = Muxes * CHANNELS;
+    using Frame = BitWords<BUTTONS>;
+
+    static_assert(Muxes <= 32, "One level bit per mux in a 32-bit word");
+
+    /// Gray code: consecutive steps differ by one address bit
+    static constexpr uint8_t channelAt(uint8_t step) { return uint8_t(step ^ (step >> 1)); }
+
+    /// Channel to drive on the address lines now
+    uint8_t channel() const { return channelAt(step_); }
+
+    /// Record the current channel's levels (bit m = mux m pressed) and advance;
+    /// true when a frame was completed (see frame())
+    bool sample(uint32_t levels) {
+        const size_t channel = channelAt(step_);
+        while (levels) {
+            const size_t bit = size_t(__builtin_ctz(levels)) * CHANNELS + channel;
+            building_[bit >> 5] |= 1u << (bit & 31);
+            levels &= levels - 1;
+        }
+        step_ = uint8_t((step_ + 1) & (CHANNELS - 1));
+        if (step_ != 0) return false;
+
+        frame_ = building_;
+        building_ = Frame{};
+        return true;
+    }
+
+    const Frame& frame() const { return frame_; }
+
+private:
+    Frame building_{};
+    Frame frame_{};
+    uint8_t step_ = 0;
+};
+
+}  // namespace input
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file QuadTracker.hpp
+ * @brief Quadrature counting stages of input::QuadDecoder, without hardware access
+ *
+ *   - QuadCounter: model of the ENC x4 position counter (host simulations, tests)
+ *   - counterDelta(): counts between two reads of the 32-bit counter, across wraps
+ *   - QuadTracker: counter deltas -> model::Position (ppr, rangeAngle, ticksPerEvent,
+ *     invertDirection of the EncoderDef)
+ *   - quadFilter(): FILT register for an IPG clock, re-derived after clock changes
+ *
+ * No Arduino or Config dependency: builds on a host (test/test_quadrature).
+ */
+
+#include "model/Parameter.hpp"
+
+#include <cstdint>
+
+namespace input {
+
+/**
+ * @brief ENC position counter model: x4 quadrature decoding of filtered A/B levels
+ *
+ * Sequence 00 -> 10 -> 11 -> 01 -> 00 (A then B rising) counts up. A transition
+ * changing both phases at once is not counted (illegal(), the hardware ignores it).
+ */
+class QuadCounter {
+public:
+    /// Feed the current phase levels
+    void update(bool a, bool b) {
+        const uint8_t state = uint8_t((a ? 2 : 0) | (b ? 1 : 0));
+        const int8_t step = STEPS[(state_ << 2) | state];
+        state_ = state;
+        if (step == ILLEGAL) {
+            ++illegal_;
+            return;
+        }
+        position_ += uint32_t(int32_t(step));
+    }
+
+    /// Counter value as read from UPOS:LPOSH (wraps)
+    uint32_t position() const { return position_; }
+    uint32_t illegal() const { return illegal_; }
+
+    /// Start from a counter value (wrap tests)
+    void preset(uint32_t position) { position_ = position; }
+
+private:
+    static constexpr int8_t ILLEGAL = 2;
+
+    /// [previous AB << 2 | current AB]
+    static constexpr int8_t STEPS[16] = {
+        0, -1, 1,  ILLEGAL,  // from 00
+        1, 0,  ILLEGAL, -1,  // from 01
+        -1, ILLEGAL, 0, 1,   // from 10
+        ILLEGAL, 1, -1, 0,   // from 11
+    };
+
+    uint32_t position_ = 0;
+    uint32_t illegal_ = 0;
+    uint8_t state_ = 0;
+};
+
+/// Signed counts between two reads of a wrapping 32-bit counter
+constexpr int32_t counterDelta(uint32_t counter, uint32_t last) {
+    return int32_t(counter - last);
+}
+
+/**
+ * @brief Counter deltas to encoder position (same role as the framework's encoder)
+ */
+class QuadTracker {
+public:
+    constexpr QuadTracker(uint16_t ppr, uint16_t rangeAngle, uint8_t ticksPerEvent, bool invert)
+        : ticks_(ticksPerEvent ? ticksPerEvent : 1),
+          step_(eventStep(ppr, rangeAngle, ticks_)),
+          invert_(invert) {}
+
+    /// Apply counts read since the previous update; true if the position moved
+    bool update(int32_t counts) {
+        pending_ += invert_ ? -counts : counts;
+        const int32_t events = pending_ / ticks_;  // Remainder kept for the next read
+        if (events == 0) return false;
+        pending_ -= events * ticks_;
+
+        const int32_t target = int32_t(position_) + events * step_;
+        const model::Position next = model::Position(
+            target < 0 ? 0 : target > model::POSITION_MAX ? model::POSITION_MAX : target);
+        if (next == position_) return false;
+        position_ = next;
+        return true;
+    }
+
+    /// Move to a position (bank change, reset, MIDI feedback); counts in progress dropped
+    void setPosition(model::Position position) {
+        position_ = position;
+        pending_ = 0;
+    }
+
+    model::Position position() const { return position_; }
+
+    /// Position units per event (rounded, at least 1)
+    static constexpr int32_t eventStep(uint16_t ppr, uint16_t rangeAngle, int32_t ticks) {
+        const int64_t countsPerRange = int64_t(4) * ppr * rangeAngle;  // x 1/360
+        if (countsPerRange == 0) return model::POSITION_MAX;
+        const int64_t step =
+            (int64_t(model::POSITION_MAX) * ticks * 360 + countsPerRange / 2) / countsPerRange;
+        return int32_t(step < 1 ? 1 : step > model::POSITION_MAX ? model::POSITION_MAX : step);
+    }
+
+private:
+    int32_t ticks_;
+    int32_t step_;
+    bool invert_;
+    int32_t pending_ = 0;  ///< Counts not yet worth an event
+    model::Position position_ = 0;
+};
+
+/// Glitch filter: FILT_CNT + 3 = 10 equal samples, one every QUAD_FILTER_SAMPLE_NS
+/// (15 us in all): contact chatter shorter than that is not counted
+constexpr uint32_t QUAD_FILTER_COUNT = 7;
+constexpr uint32_t QUAD_FILTER_SAMPLE_NS = 1500;
+
+/// FILT register for an IPG clock (sample period in IPG cycles, 1-255)
+constexpr uint16_t quadFilter(uint32_t busHz) {
+    const uint64_t cycles = uint64_t(busHz) * QUAD_FILTER_SAMPLE_NS / 1'000'000'000;
+    const uint32_t period = uint32_t(cycles < 1 ? 1 : cycles > 255 ? 255 : cycles);
+    return uint16_t((QUAD_FILTER_COUNT << 8) | period);
+}
+
+}  // namespace input
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file ScanQueue.hpp
+ * @brief Scan frames from a timer ISR to the app tick, debounced into edges
+ *
+ * Shared by the background button scanners (MuxScanner, MatrixScanner):
+ *   - push() (scan ISR, single producer): queue a complete frame; a full queue
+ *     drops it (the app is not polling, e.g. during a long redraw)
+ *   - poll() (app update, single consumer): debounce queued frames in order and
+ *     hand out the press/release edges of each frame that has some
+ */
+
+#include <Arduino.h>
+
+#include "input/Debouncer.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace input {
+
+/**
+ * @tparam Buttons        Bits per frame
+ * @tparam QueueSize      Frames buffered (power of two)
+ * @tparam DebounceFrames Consecutive frames a change must last
+ */
+template <size_t Buttons, size_t QueueSize, uint32_t DebounceFrames>
+class ScanQueue {
+public:
+    using Frame = BitWords<Buttons>;
+    using Debouncer = VerticalDebouncer<Buttons, counterBits(DebounceFrames)>;
+
+    static_assert((QueueSize & (QueueSize - 1)) == 0, "Scan queue size must be a power of two");
+
+    struct Stats {
+        uint32_t frames = 0;      ///< Frames debounced
+        uint32_t dropped = 0;     ///< Frames lost to a full queue (poll not running)
+        uint32_t lastPollUs = 0;
+        uint32_t maxPollUs = 0;
+    };
+
+    ScanQueue() : debouncer_(DebounceFrames) {}
+
+    /// ISR: queue a complete frame
+    void push(const Frame& frame) {
+        const uint32_t head = head_;
+        if (head - tail_ == QueueSize) {
+            ++stats_.dropped;
+            return;
+        }
+        queue_[head & (QueueSize - 1)] = frame;
+        std::atomic_signal_fence(std::memory_order_release);
+        head_ = head + 1;
+    }
+
+    /// Debounce queued frames, fn(const Edges<Buttons>&) for each frame with edges
+    template <typename Fn>
+    size_t poll(Fn&& fn) {
+        const uint32_t start = micros();
+        uint32_t tail = tail_;
+        const uint32_t head = head_;
+        std::atomic_signal_fence(std::memory_order_acquire);  // Slots written before head_
+        size_t count = 0;
+        for (; tail != head; ++tail, ++count) {
+            const Edges<Buttons> edges = debouncer_.update(queue_[tail & (QueueSize - 1)]);
+            if (edges.any()) fn(edges);
+        }
+        std::atomic_signal_fence(std::memory_order_release);
+        tail_ = tail;
+        if (count == 0) return 0;
+
+        stats_.frames += count;
+        stats_.lastPollUs = micros() - start;
+        if (stats_.lastPollUs > stats_.maxPollUs) stats_.maxPollUs = stats_.lastPollUs;
+        return count;
+    }
+
+    /// Debounced state
+    const Frame& state() const { return debouncer_.state(); }
+    const Stats& stats() const { return stats_; }
+
+private:
+    std::array<Frame, QueueSize> queue_{};
+    volatile uint32_t head_ = 0;
+    volatile uint32_t tail_ = 0;
+    Debouncer debouncer_;
+    Stats stats_;
+};
+
+}  // namespace input
@@ -49,10 +49,13 @@
 #define LV_DRAW_SW_SUPPORT_ARGB8888 0
 #define LV_DRAW_SW_SUPPORT_L8 0
 #define LV_DRAW_SW_SUPPORT_AL88 0
-#define LV_DRAW_SW_SUPPORT_A8 0
+#define LV_DRAW_SW_SUPPORT_A8 1  // LabelCache rasterizes glyph coverage into A8
 #define LV_DRAW_SW_SUPPORT_I1 0
 #define LV_DRAW_SW_DRAW_UNIT_CNT 0
 #define LV_DRAW_SW_COMPLEX 1
+// Stock C blend loops: LVGL already fills with word stores and mixes RGB565 one pixel per
+// 32-bit word. The M7 DSP has no independent dual 16-bit multiply (SMLAD sums both lanes),
+// so a 2-pixel kernel still needs one multiply per channel and pixel: nothing to gain
 #define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_NONE
 #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS 1
 #endif
@@ -113,7 +116,7 @@
 #define LV_FONT_MONTSERRAT_48 0
 #define LV_FONT_DEFAULT &lv_font_montserrat_12
 #define LV_FONT_FMT_TXT_LARGE 0
-#define LV_USE_FONT_COMPRESSED 1
+#define LV_USE_FONT_COMPRESSED 0  // Built-in Montserrat fonts are stored uncompressed
 #define LV_USE_FONT_PLACEHOLDER 1
 
 #define LV_TXT_ENC LV_TXT_ENC_UTF8
@@ -127,7 +130,7 @@
 #define LV_USE_BAR 1
 #define LV_USE_BUTTON 1
 #define LV_USE_BUTTONMATRIX 0
-#define LV_USE_CANVAS 0
+#define LV_USE_CANVAS 1  // LabelCache offscreen rendering
 #define LV_USE_CHECKBOX 0
 #define LV_USE_DROPDOWN 0
 #define LV_USE_IMAGE 1
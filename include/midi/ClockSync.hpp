@@ -0,0 +1,154 @@
+#pragma once
+
+/**
+ * @file ClockSync.hpp
+ * @brief MIDI clock follower: jitter-filtered tempo and beat phase
+ *
+ * MIDI clock is 24 F8 ticks per quarter note. Raw tick intervals jitter by
+ * the USB frame period (1 ms full speed) plus host scheduling, so the tick
+ * period is tracked with a second-order delay-locked loop (DLL):
+ *
+ *   error     = tickTime - predictedTickTime
+ *   tickTime' = predicted + b * error        (filtered time of this tick)
+ *   predicted = tickTime' + period
+ *   period   += c * error
+ *
+ * b = sqrt(2) * w, c = w^2, w = 2 pi ClockSettings::dllBandwidth (cycles per tick):
+ * critically damped, low bandwidth = smoother tempo, slower to follow changes.
+ *
+ * Tick times must be reception timestamps (see UsbMidiInput), not processing
+ * times. beats(now) interpolates between filtered ticks for smooth modulation.
+ * No Arduino or Config dependency: builds on a host (test/test_clocksync). The
+ * DAW context passes the Config::Midi CLOCK_* settings.
+ */
+
+#include "midi/UsbMidiParser.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace midi {
+
+struct ClockSettings {
+    double dllBandwidth;  ///< Cycles per tick
+    double relockRatio;   ///< Tick error (in periods) that resets the DLL
+    uint32_t timeoutUs;   ///< No tick for this long: unlocked
+};
+
+class ClockSync : public MidiSink {
+public:
+    static constexpr uint32_t TICKS_PER_BEAT = 24;
+
+    explicit ClockSync(const ClockSettings& settings) : settings_(settings) {}
+
+    struct Stats {
+        uint32_t ticks = 0;
+        uint32_t relocks = 0;   ///< Tick period jumped (tempo change, dropout): DLL reset
+        float jitterUs = 0.0f;  ///< Mean absolute tick error vs DLL prediction
+    };
+
+    // ═══════════════════════════════════════════════════════════════════
+    // MidiSink
+    // ═══════════════════════════════════════════════════════════════════
+
+    void onRealtime(uint8_t status, uint32_t timeUs) {
+        switch (status) {
+            case 0xF8: tick(timeUs); break;
+            case 0xFA:  // Start: next tick is beat 0
+                ticks_ = 0;
+                running_ = true;
+                break;
+            case 0xFB: running_ = true; break;  // Continue
+            case 0xFC: running_ = false; break;  // Stop
+            default: break;
+        }
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Tempo / phase
+    // ═══════════════════════════════════════════════════════════════════
+
+    /// Clock received recently and tracked
+    bool locked(uint32_t nowUs) const {
+        return locked_ && nowUs - lastTickUs_ < settings_.timeoutUs;
+    }
+
+    /// Transport playing (Start/Continue received, no Stop) and clock locked
+    bool running(uint32_t nowUs) const { return running_ && locked(nowUs); }
+
+    float bpm() const { return locked_ ? 60e6f / (float(period_) * TICKS_PER_BEAT) : 0.0f; }
+
+    /// Filtered tick period in microseconds
+    double periodUs() const { return period_; }
+
+    /// Beats since Start at nowUs, interpolated (held at the last tick + 1 if ticks stop)
+    double beats(uint32_t nowUs) const {
+        if (!locked_ || ticks_ == 0) return 0.0;
+        double frac = (double(int32_t(nowUs - lastTickUs_)) - lastTickOffset_) / period_;
+        if (frac < 0.0) frac = 0.0;
+        if (frac > 1.0) frac = 1.0;
+        return (double(ticks_ - 1) + frac) / TICKS_PER_BEAT;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    void tick(uint32_t timeUs) {
+        ++stats_.ticks;
+        if (running_) ++ticks_;
+
+        if (!hasTick_) {
+            hasTick_ = true;
+            lastTickUs_ = timeUs;
+            return;
+        }
+
+        const double interval = double(timeUs - lastTickUs_);
+        if (!locked_) {
+            relock(timeUs, interval);
+            return;
+        }
+
+        // Error vs prediction, relative to the previous raw tick time
+        const double error = interval - predictedOffset_;
+        if (std::fabs(error) > period_ * settings_.relockRatio) {
+            ++stats_.relocks;
+            relock(timeUs, interval);
+            return;
+        }
+
+        constexpr double TWO_PI = 6.283185307179586;
+        const double w = TWO_PI * settings_.dllBandwidth;
+        const double b = std::sqrt(2.0) * w;
+        const double c = w * w;
+
+        // Filtered time of this tick and prediction of the next, relative to timeUs
+        lastTickOffset_ = predictedOffset_ + b * error - interval;
+        predictedOffset_ = lastTickOffset_ + period_;
+        period_ += c * error;
+        lastTickUs_ = timeUs;
+
+        stats_.jitterUs += (float(std::fabs(error)) - stats_.jitterUs) / 16.0f;
+    }
+
+    void relock(uint32_t timeUs, double interval) {
+        period_ = interval;
+        lastTickOffset_ = 0.0;
+        predictedOffset_ = interval;
+        lastTickUs_ = timeUs;
+        locked_ = interval > 0.0 && interval < settings_.timeoutUs;
+    }
+
+    ClockSettings settings_;
+    double period_ = 0.0;           ///< Filtered tick period (us)
+    double lastTickOffset_ = 0.0;   ///< Filtered time of the last tick - lastTickUs_
+    double predictedOffset_ = 0.0;  ///< Predicted next tick time - lastTickUs_
+    uint32_t lastTickUs_ = 0;       ///< Raw reception time of the last tick
+    uint32_t ticks_ = 0;            ///< Ticks since Start (transport position)
+    bool hasTick_ = false;
+    bool locked_ = false;
+    bool running_ = false;
+    Stats stats_;
+};
+
+}  // namespace midi
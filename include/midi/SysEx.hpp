@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file SysEx.hpp
+ * @brief SysEx framing, 7-bit packing and streaming decoder
+ *
+ * Message layout:
+ *
+ *   F0  MANUFACTURER  DEVICE  COMMAND  <packed payload...>  CHECKSUM  F7
+ *
+ * Payload bytes are 8-bit; SysEx data bytes are 7-bit. Each group of up to
+ * 7 payload bytes is sent as one byte holding their MSBs (bit i = byte i)
+ * followed by their 7 low bits: 8 SysEx bytes per 7 payload bytes.
+ * CHECKSUM makes COMMAND + packed bytes + CHECKSUM sum to 0 (mod 128).
+ *
+ * The decoder takes bytes as they arrive (1-3 per USB-MIDI packet) and unpacks
+ * on the fly into a fixed buffer: no full-message buffering, no allocation.
+ * No Arduino dependency: builds on a host.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace midi::sysex {
+
+constexpr uint8_t START = 0xF0;
+constexpr uint8_t END = 0xF7;
+constexpr uint8_t ALL_DEVICES = 0x7F;
+
+/// SysEx data bytes needed for n payload bytes
+constexpr size_t packedSize(size_t n) { return n + (n + 6) / 7; }
+
+/// Complete message size: F0 manufacturer device command ... checksum F7
+constexpr size_t messageSize(size_t payloadBytes) { return packedSize(payloadBytes) + 6; }
+
+/**
+ * @brief Build a complete message into out (messageSize(size) bytes), return its size
+ */
+inline size_t encode(uint8_t manufacturer, uint8_t device, uint8_t command,
+                     const uint8_t* payload, size_t size, uint8_t* out) {
+    uint8_t* p = out;
+    *p++ = START;
+    *p++ = manufacturer;
+    *p++ = device;
+    *p++ = command;
+
+    uint32_t sum = command;
+    for (size_t group = 0; group < size; group += 7) {
+        const size_t count = size - group < 7 ? size - group : 7;
+        uint8_t* msbs = p++;
+        *msbs = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t byte = payload[group + i];
+            *msbs |= uint8_t((byte >> 7) << i);
+            *p = byte & 0x7F;
+            sum += *p++;
+        }
+        sum += *msbs;
+    }
+
+    *p++ = uint8_t(-sum) & 0x7F;
+    *p++ = END;
+    return size_t(p - out);
+}
+
+/**
+ * @brief Streaming decoder for messages addressed to (manufacturer, device)
+ *
+ * feed() returns COMPLETE once per valid message; command() and payload() stay
+ * valid until the next byte is fed.
+ *
+ * @tparam Capacity Largest payload accepted (unpacked bytes)
+ */
+template <size_t Capacity>
+class Decoder {
+public:
+    enum class Result : uint8_t {
+        PENDING,   ///< Byte consumed, message not finished
+        COMPLETE,  ///< Valid message available
+        ERROR,     ///< Checksum, overflow or framing error (message dropped)
+        IGNORED,   ///< Not in a message for this device
+    };
+
+    struct Stats {
+        uint32_t messages = 0;
+        uint32_t errors = 0;
+    };
+
+    Decoder(uint8_t manufacturer, uint8_t device) : manufacturer_(manufacturer), device_(device) {}
+
+    Result feed(const uint8_t* data, size_t size) {
+        Result result = Result::IGNORED;
+        for (size_t i = 0; i < size; ++i) {
+            const Result r = feed(data[i]);
+            if (r != Result::IGNORED) result = r;
+            if (r == Result::COMPLETE || r == Result::ERROR) break;  // END is last in chunk
+        }
+        return result;
+    }
+
+    Result feed(uint8_t byte) {
+        if (byte == START) {
+            state_ = State::MANUFACTURER;
+            return Result::PENDING;
+        }
+        if (byte == END) return finish();
+        if (byte & 0x80) return abort();  // Status byte inside a message
+
+        switch (state_) {
+            case State::IDLE: return Result::IGNORED;
+            case State::MANUFACTURER:
+                state_ = byte == manufacturer_ ? State::DEVICE : State::IDLE;
+                break;
+            case State::DEVICE:
+                state_ = byte == device_ || byte == ALL_DEVICES ? State::COMMAND : State::IDLE;
+                break;
+            case State::COMMAND:
+                command_ = byte;
+                sum_ = byte;
+                size_ = 0;
+                group_ = 0;
+                hasPending_ = false;
+                overflow_ = false;
+                state_ = State::DATA;
+                break;
+            case State::DATA:
+                // Last data byte is the checksum: lag one byte behind
+                if (hasPending_) unpack(pending_);
+                pending_ = byte;
+                hasPending_ = true;
+                break;
+        }
+        return state_ == State::IDLE ? Result::IGNORED : Result::PENDING;
+    }
+
+    uint8_t command() const { return command_; }
+    const uint8_t* payload() const { return payload_.data(); }
+    size_t size() const { return size_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    enum class State : uint8_t { IDLE, MANUFACTURER, DEVICE, COMMAND, DATA };
+
+    void unpack(uint8_t byte) {
+        sum_ += byte;
+        if (group_ == 0) {
+            msbs_ = byte;
+        } else if (size_ < Capacity) {
+            payload_[size_++] = uint8_t(byte | ((msbs_ >> (group_ - 1)) & 1) << 7);
+        } else {
+            overflow_ = true;
+        }
+        group_ = group_ == 7 ? 0 : group_ + 1;
+    }
+
+    Result finish() {
+        const State state = state_;
+        state_ = State::IDLE;
+        if (state == State::IDLE) return Result::IGNORED;
+
+        // Needs at least the checksum byte, whole groups and a matching sum
+        const bool valid = state == State::DATA && hasPending_ && !overflow_ && group_ != 1 &&
+                           ((sum_ + pending_) & 0x7F) == 0;
+        if (!valid) {
+            ++stats_.errors;
+            return Result::ERROR;
+        }
+        ++stats_.messages;
+        return Result::COMPLETE;
+    }
+
+    Result abort() {
+        if (state_ == State::IDLE) return Result::IGNORED;
+        state_ = State::IDLE;
+        ++stats_.errors;
+        return Result::ERROR;
+    }
+
+    uint8_t manufacturer_;
+    uint8_t device_;
+    State state_ = State::IDLE;
+    uint8_t command_ = 0;
+    uint8_t msbs_ = 0;
+    uint8_t group_ = 0;  ///< Position in the current 8-byte group (0 = MSB byte)
+    uint8_t pending_ = 0;
+    bool hasPending_ = false;
+    bool overflow_ = false;
+    uint32_t sum_ = 0;
+    size_t size_ = 0;
+    std::array<uint8_t, Capacity> payload_{};
+    Stats stats_;
+};
+
+}  // namespace midi::sysex
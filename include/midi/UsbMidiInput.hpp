@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file UsbMidiInput.hpp
+ * @brief Timestamped capture of USB-MIDI packets, decoded by a UsbMidiParser
+ *
+ * Two stages:
+ *   - capture (IntervalTimer ISR, Config::Midi::IN_CAPTURE_HZ): moves packets from
+ *     the USB receive queue to a ring with their reception time (micros()).
+ *     MIDI clock timing thus has the capture period as resolution, not the app
+ *     loop period, and does not depend on how busy the loop is.
+ *   - poll (app update): decodes queued packets in place. The number per poll is
+ *     bounded (Config::Midi::IN_PACKETS_PER_POLL) so a large burst (a DAW
+ *     resending every parameter on project load) is spread over a few updates
+ *     instead of stalling encoder polling.
+ *
+ * usbMIDI.readPacket() hands out each 32-bit event packet as received, without
+ * going through usbMIDI.read() and its per-message getters. When the ring is
+ * full, packets stay in the USB queue (host flow control) until the next capture.
+ *
+ * Requires -D USB_MIDI_SERIAL (or another USB_MIDI* type) in build_flags.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "midi/UsbMidiParser.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace midi {
+
+class UsbMidiInput {
+public:
+    static constexpr size_t QUEUE_SIZE = Config::Midi::IN_QUEUE_SIZE;
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "IN_QUEUE_SIZE must be a power of two");
+
+    struct Stats {
+        uint32_t polls = 0;      ///< Polls that received at least one packet
+        uint32_t lastBurst = 0;  ///< Packets drained by the last such poll
+        uint32_t maxBurst = 0;
+        uint32_t lastPollUs = 0;
+        uint32_t queueFull = 0;  ///< Captures that left packets in the USB queue
+    };
+
+    /// Start capturing (one input at a time: call from the owning context's initialize())
+    void begin() {
+        active_ = this;
+        timer_.begin(onCapture, 1'000'000 / Config::Midi::IN_CAPTURE_HZ);
+        timer_.priority(Config::Midi::IN_CAPTURE_PRIORITY);
+    }
+
+    /// Stop capturing; queued packets are kept for the next begin()
+    void end() {
+        timer_.end();
+        if (active_ == this) active_ = nullptr;
+    }
+
+    /// Decode queued packets into sink, return the number of packets decoded
+    template <typename Sink>
+    size_t poll(Sink& sink) {
+        const uint32_t start = micros();
+        size_t count = 0;
+        uint32_t tail = tail_;
+        const uint32_t head = head_;
+        std::atomic_signal_fence(std::memory_order_acquire);  // Slots written before head_
+        while (count < Config::Midi::IN_PACKETS_PER_POLL && tail != head) {
+            const Packet& packet = queue_[tail & (QUEUE_SIZE - 1)];
+            parser_.parse(packet.data, packet.timeUs, sink);
+            ++tail;
+            ++count;
+        }
+        std::atomic_signal_fence(std::memory_order_release);
+        tail_ = tail;  // Slots released to the ISR only after they were decoded
+        if (count == 0) return 0;
+
+        ++stats_.polls;
+        stats_.lastBurst = count;
+        if (count > stats_.maxBurst) stats_.maxBurst = count;
+        stats_.lastPollUs = micros() - start;
+        return count;
+    }
+
+    const Stats& stats() const { return stats_; }
+    const UsbMidiParser::Stats& parserStats() const { return parser_.stats(); }
+
+private:
+    struct Packet {
+        uint32_t data;
+        uint32_t timeUs;  ///< Reception time (capture ISR)
+    };
+
+    static void onCapture() {
+        if (active_) active_->capture();
+    }
+
+    /// ISR: single producer of queue_ (head_), poll() is the single consumer (tail_)
+    void capture() {
+        const uint32_t now = micros();
+        uint32_t head = head_;
+        while (head - tail_ < QUEUE_SIZE) {
+            const uint32_t packet = usbMIDI.readPacket();
+            if (packet == 0) break;
+            queue_[head & (QUEUE_SIZE - 1)] = {packet, now};
+            ++head;
+        }
+        if (head - tail_ == QUEUE_SIZE) ++stats_.queueFull;
+        std::atomic_signal_fence(std::memory_order_release);
+        head_ = head;
+    }
+
+    static inline UsbMidiInput* active_ = nullptr;
+
+    IntervalTimer timer_;
+    std::array<Packet, QUEUE_SIZE> queue_{};
+    volatile uint32_t head_ = 0;
+    volatile uint32_t tail_ = 0;
+    UsbMidiParser parser_{UsbMidiParser::hiresMask(Config::Midi::HIRES_CCS)};
+    Stats stats_;
+};
+
+}  // namespace midi
@@ -0,0 +1,258 @@
+#pragma once
+
+/**
+ * @file ControlState.hpp
+ * @brief Encoder/button state model with per-frame dirty tracking
+ *
+ * Decouples input rate from display rate:
+ *   Handler  --(APP_HZ, up to 2 kHz)-->  ControlState  --(LVGL_HZ, once per frame)-->  View
+ *
+ * Encoder values are fixed-point positions (model::Position, 0-65535).
+ * Writers overwrite the latest value and set a dirty bit. The view sync step
+ * consumes dirty bits once per refresh, so only the last value of each control
+ * since the previous frame reaches the widgets.
+ *
+ * Encoder writes are urgent (local input, bank switch) or deferrable (setSlot():
+ * MIDI feedback, restore). A view over its frame budget applies the urgent ones and
+ * admits deferrable ones one by one; the others stay dirty for a later frame.
+ *
+ * Encoder banks: the values of all banks live in one contiguous array, indexed by
+ * slot = bank * ENCODER_COUNT + encoder. encoder(i)/setEncoder(i) address the active
+ * bank through a base offset, so switching banks moves the offset and marks the
+ * encoders dirty: no values are copied.
+ */
+
+#include "Config.hpp"
+#include "model/Parameter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace model {
+
+/**
+ * @brief Fixed-size dirty bitset, consumed in index order with count-trailing-zeros
+ */
+template <size_t N>
+class DirtyBits {
+public:
+    static constexpr size_t WORDS = (N + 31) / 32;
+
+    void set(size_t index) { words_[index >> 5] |= 1u << (index & 31); }
+
+    void setAll() {
+        for (size_t i = 0; i < N; ++i) set(i);
+    }
+
+    void reset(size_t index) { words_[index >> 5] &= ~(1u << (index & 31)); }
+
+    bool test(size_t index) const { return words_[index >> 5] & (1u << (index & 31)); }
+
+    bool any() const {
+        for (uint32_t word : words_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    /// Call fn(index) for each set bit and clear them
+    template <typename Fn>
+    void consume(Fn&& fn) {
+        for (size_t w = 0; w < WORDS; ++w) {
+            uint32_t bits = words_[w];
+            words_[w] = 0;
+            while (bits) {
+                fn(w * 32 + size_t(__builtin_ctz(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    std::array<uint32_t, WORDS> words_{};
+};
+
+/**
+ * @brief Latest encoder values and button states, with dirty bits for view sync
+ *
+ * @tparam EncoderCount Number of encoders (Config::Encoder::ENCODERS.size())
+ * @tparam ButtonCount  Number of buttons (Config::Button::COUNT)
+ * @tparam BankCount    Number of encoder banks (Config::Encoder::BANKS)
+ */
+template <size_t EncoderCount, size_t ButtonCount, size_t BankCount = 1>
+class ControlState {
+public:
+    static constexpr size_t ENCODER_COUNT = EncoderCount;
+    static constexpr size_t BUTTON_COUNT = ButtonCount;
+    static constexpr size_t BANK_COUNT = BankCount;
+    static constexpr size_t SLOT_COUNT = BankCount * EncoderCount;  ///< Values of all banks
+    static constexpr Position DEFAULT_POSITION = POSITION_CENTER;
+
+    struct Stats {
+        uint32_t writes = 0;   ///< Model writes (input rate)
+        uint32_t applied = 0;  ///< Values handed to the view (at most one per control per frame)
+    };
+
+    ControlState() {
+        slots_.fill(DEFAULT_POSITION);
+        markAllDirty();
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Writers (Handler, input rate)
+    // ═══════════════════════════════════════════════════════════════════
+
+    /// Local input: urgent
+    void setEncoder(size_t index, Position position) {
+        if (index >= ENCODER_COUNT) return;
+        writeEncoder(index, position);
+        encoderUrgent_.set(index);
+    }
+
+    /// Write a value of any bank (MIDI feedback, restore); dirty only if in the active
+    /// bank, deferrable
+    void setSlot(size_t slot, Position position) {
+        if (slot >= SLOT_COUNT) return;
+        if (slot - bankBase_ < ENCODER_COUNT) {
+            writeEncoder(slot - bankBase_, position);
+            return;
+        }
+        slots_[slot] = position;
+    }
+
+    /// Make `bank` the active one; timeUs = when it was requested (bank switch latency)
+    bool setBank(size_t bank, uint32_t timeUs) {
+        if (bank >= BANK_COUNT || bank == bank_) return false;
+        bank_ = bank;
+        bankBase_ = bank * ENCODER_COUNT;
+        bankSwitchUs_ = timeUs;
+        bankSwitched_ = true;
+        bankDirty_ = true;
+        stats_.writes += ENCODER_COUNT;
+        encoderDirty_.setAll();
+        encoderUrgent_.setAll();  // Shown at once, never mixed with the previous bank
+        return true;
+    }
+
+    void setButton(size_t index, bool pressed) {
+        if (index >= BUTTON_COUNT) return;
+        ++stats_.writes;
+        buttons_[index] = pressed;
+        buttonDirty_.set(index);
+    }
+
+    void resetEncoders() {
+        for (size_t i = 0; i < ENCODER_COUNT; ++i) setEncoder(i, DEFAULT_POSITION);
+    }
+
+    /// Force a full view sync (e.g. after the view re-created its widgets)
+    void markAllDirty() {
+        stats_.writes += ENCODER_COUNT + BUTTON_COUNT;  // Keeps writes >= applied
+        encoderDirty_.setAll();
+        encoderUrgent_.setAll();
+        buttonDirty_.setAll();
+        bankDirty_ = true;
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Readers
+    // ═══════════════════════════════════════════════════════════════════
+
+    Position encoder(size_t index) const { return slots_[bankBase_ + index]; }
+    Position slot(size_t slot) const { return slots_[slot]; }
+    bool button(size_t index) const { return buttons_[index]; }
+    size_t bank() const { return bank_; }
+
+    bool dirty() const { return bankDirty_ || encoderDirty_.any() || buttonDirty_.any(); }
+
+    /// View sync step: fn(index, position) for each changed encoder, clears dirty bits
+    template <typename Fn>
+    void consumeEncoders(Fn&& fn) {
+        encoderUrgent_ = {};
+        encoderDirty_.consume([&](size_t i) {
+            ++stats_.applied;
+            fn(i, slots_[bankBase_ + i]);
+        });
+    }
+
+    /// Same for urgent encoders, and for deferrable ones where admit() returns true;
+    /// the others stay dirty. Deferrable ones start after the last one applied, so a
+    /// tight budget still reaches every encoder in turn
+    template <typename Admit, typename Fn>
+    void consumeEncoders(Admit&& admit, Fn&& fn) {
+        auto apply = [&](size_t i) {
+            encoderDirty_.reset(i);
+            ++stats_.applied;
+            fn(i, slots_[bankBase_ + i]);
+        };
+        encoderUrgent_.consume(apply);
+
+        size_t held = ENCODER_COUNT;
+        for (size_t k = 0; k < ENCODER_COUNT; ++k) {
+            const size_t i = (deferredFrom_ + k) % ENCODER_COUNT;
+            if (!encoderDirty_.test(i)) continue;
+            if (admit()) {
+                apply(i);
+            } else if (held == ENCODER_COUNT) {
+                held = i;
+            }
+        }
+        deferredFrom_ = held == ENCODER_COUNT ? 0 : held;
+    }
+
+    /// View sync step: fn(bank, switched, switchUs) if the bank display is stale;
+    /// switched = a setBank() since the last call (switchUs = its request time)
+    template <typename Fn>
+    void consumeBank(Fn&& fn) {
+        if (!bankDirty_) return;
+        bankDirty_ = false;
+        fn(bank_, bankSwitched_, bankSwitchUs_);
+        bankSwitched_ = false;
+    }
+
+    /// View sync step: fn(index, pressed) for each changed button, clears dirty bits
+    template <typename Fn>
+    void consumeButtons(Fn&& fn) {
+        buttonDirty_.consume([&](size_t i) {
+            ++stats_.applied;
+            fn(i, buttons_[i]);
+        });
+    }
+
+    const Stats& stats() const { return stats_; }
+
+    /// Widget updates skipped thanks to per-frame coalescing
+    uint32_t writesAvoided() const {
+        return stats_.writes > stats_.applied ? stats_.writes - stats_.applied : 0;
+    }
+
+private:
+    void writeEncoder(size_t index, Position position) {
+        ++stats_.writes;
+        slots_[bankBase_ + index] = position;
+        encoderDirty_.set(index);
+    }
+
+    std::array<Position, SLOT_COUNT> slots_{};  ///< Bank-major: all banks, contiguous
+    std::array<bool, BUTTON_COUNT> buttons_{};
+    DirtyBits<ENCODER_COUNT> encoderDirty_;
+    DirtyBits<ENCODER_COUNT> encoderUrgent_;  ///< Subset of encoderDirty_
+    DirtyBits<BUTTON_COUNT> buttonDirty_;
+    size_t bank_ = 0;
+    size_t bankBase_ = 0;      ///< bank_ * ENCODER_COUNT
+    size_t deferredFrom_ = 0;  ///< First deferrable encoder held back by the last sync
+    uint32_t bankSwitchUs_ = 0;
+    bool bankSwitched_ = false;
+    bool bankDirty_ = false;
+    Stats stats_;
+};
+
+/// Parameters of the encoders declared in Config.hpp (same order)
+inline constexpr auto ENCODER_PARAMETERS = makeParameters(Config::Encoder::PARAMS);
+
+/// State of the panel declared in Config.hpp
+using PanelState =
+    ControlState<Config::Encoder::ENCODERS.size(), Config::Button::COUNT, Config::Encoder::BANKS>;
+
+}  // namespace model
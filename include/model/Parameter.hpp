@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+ * @file Parameter.hpp
+ * @brief Fixed-point encoder parameter model (range, step, detent, curve)
+ *
+ * Encoder positions are 16-bit fixed point (0 = 0.0, 65535 = 1.0). The framework
+ * reports normalized floats: they are converted once at the input boundary
+ * (toPosition), then everything is integer:
+ *
+ *   raw position --detent--> position --curve LUT--> curved --range/step--> output
+ *
+ * Curves are 257-entry tables computed at compile time and interpolated
+ * linearly on the low 8 bits; every stage is monotonic (non-decreasing), so the
+ * output is too, and the same position always gives the same output.
+ * No Arduino or Config dependency: builds on a host. Config::Encoder::PARAMS are
+ * ParamDefs; the matching Parameters are model::ENCODER_PARAMETERS (ControlState.hpp).
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace model {
+
+using Position = uint16_t;
+constexpr Position POSITION_MAX = 0xFFFF;
+constexpr Position POSITION_CENTER = 0x8000;
+
+/// Framework boundary: normalized float (0.0-1.0) to position
+inline Position toPosition(float normalized) {
+    if (normalized <= 0.0f) return 0;
+    if (normalized >= 1.0f) return POSITION_MAX;
+    return Position(normalized * POSITION_MAX + 0.5f);
+}
+
+/// Framework boundary: position to normalized float (encoder setPosition)
+inline float toNormalized(Position position) { return float(position) / POSITION_MAX; }
+
+/// LINEAR, LOG (fine control at the top) or EXP (fine control at the bottom)
+enum class Curve : uint8_t { LINEAR, LOG, EXP };
+
+/// Output range, quantum, center snap half-width (position units) and curve
+struct ParamDef {
+    int16_t min = 0;
+    int16_t max = 127;
+    uint16_t step = 1;
+    uint16_t detent = 0;
+    Curve curve = Curve::LINEAR;
+};
+
+namespace detail {
+
+/// Taylor series, exact enough for |x| <= 8 in double (compile time only)
+constexpr double constExp(double x) {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 60; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    return sum;
+}
+
+using CurveLut = std::array<uint16_t, 257>;
+
+/// Curvature of LOG/EXP: exp(K x) normalized, higher = stronger
+constexpr double CURVE_K = 4.0;
+
+/// EXP: (e^(Kx) - 1) / (e^K - 1); LOG mirrors it: 1 - EXP(1 - x)
+constexpr CurveLut makeCurve(bool log) {
+    CurveLut lut{};
+    const double scale = constExp(CURVE_K) - 1.0;
+    for (size_t i = 0; i < lut.size(); ++i) {
+        double x = double(i * 256) / POSITION_MAX;
+        if (x > 1.0) x = 1.0;
+        double y = log ? 1.0 - (constExp(CURVE_K * (1.0 - x)) - 1.0) / scale
+                       : (constExp(CURVE_K * x) - 1.0) / scale;
+        if (y < 0.0) y = 0.0;
+        if (y > 1.0) y = 1.0;
+        lut[i] = uint16_t(y * POSITION_MAX + 0.5);
+    }
+    return lut;
+}
+
+inline constexpr CurveLut EXP_LUT = makeCurve(false);
+inline constexpr CurveLut LOG_LUT = makeCurve(true);
+
+}  // namespace detail
+
+/**
+ * @brief One encoder's mapping from position to output value
+ */
+class Parameter {
+public:
+    /// Result of an encoder move
+    struct Value {
+        Position position;  ///< After detent snap (what the display shows)
+        int32_t output;     ///< Integer output (CC value)
+    };
+
+    constexpr explicit Parameter(const ParamDef& def)
+        : min_(def.min),
+          span_(def.max - def.min),
+          step_(def.step ? def.step : 1),
+          detent_(def.detent),
+          lut_(def.curve == Curve::EXP   ? &detail::EXP_LUT
+               : def.curve == Curve::LOG ? &detail::LOG_LUT
+                                         : nullptr) {}
+
+    /// Hot path: raw encoder position to display position + output (integer only)
+    Value apply(Position raw) const {
+        const Position position = snap(raw);
+        return {position, output(position)};
+    }
+
+    /// Output value of a (snapped) position
+    int32_t output(Position position) const {
+        const uint32_t curved = curve(position);
+        // Endpoints exact: 0 -> min, POSITION_MAX -> max
+        uint32_t offset = (curved * uint32_t(span_) + POSITION_MAX / 2) / POSITION_MAX;
+        if (step_ > 1) {
+            offset = (offset + step_ / 2) / step_ * step_;
+            if (offset > uint32_t(span_)) offset -= step_;
+        }
+        return min_ + int32_t(offset);
+    }
+
+    /// Position at the middle of the range giving `value` (MIDI feedback, restore)
+    Position positionOf(int32_t value) const {
+        if (value <= min_) return 0;
+        if (value >= min_ + span_) return POSITION_MAX;
+        const uint32_t first = lowerBound(value);
+        const uint32_t next = lowerBound(value + 1);
+        return Position((first + next - 1) / 2);
+    }
+
+    int32_t min() const { return min_; }
+    int32_t max() const { return min_ + span_; }
+
+private:
+    Position snap(Position raw) const {
+        const int32_t distance = int32_t(raw) - POSITION_CENTER;
+        return distance <= detent_ && distance >= -detent_ ? POSITION_CENTER : raw;
+    }
+
+    uint32_t curve(Position position) const {
+        if (!lut_ || position == POSITION_MAX) return position;
+        const uint32_t index = position >> 8;
+        const uint32_t frac = position & 0xFF;
+        const uint32_t a = (*lut_)[index];
+        const uint32_t b = (*lut_)[index + 1];
+        return a + (((b - a) * frac) >> 8);
+    }
+
+    /// First position whose output is >= value (output is monotonic)
+    uint32_t lowerBound(int32_t value) const {
+        uint32_t lo = 0;
+        uint32_t hi = uint32_t(POSITION_MAX) + 1;
+        while (lo < hi) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (output(Position(mid)) < value) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    int32_t min_;
+    int32_t span_;
+    uint32_t step_;
+    int32_t detent_;
+    const detail::CurveLut* lut_;
+};
+
+namespace detail {
+template <size_t N, size_t... I>
+constexpr std::array<Parameter, N> makeParameters(const std::array<ParamDef, N>& defs,
+                                                  std::index_sequence<I...>) {
+    return {{Parameter(defs[I])...}};
+}
+}  // namespace detail
+
+/// One Parameter per definition (same order), built at compile time
+template <size_t N>
+constexpr std::array<Parameter, N> makeParameters(const std::array<ParamDef, N>& defs) {
+    return detail::makeParameters(defs, std::make_index_sequence<N>{});
+}
+
+}  // namespace model
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file StateDump.hpp
+ * @brief Binary snapshot of a ControlState (SysEx bulk dump payload)
+ *
+ * Layout (before 7-bit packing, see midi/SysEx.hpp):
+ *
+ *   [0]    FORMAT_VERSION
+ *   [1]    encoder value count (all banks: State::SLOT_COUNT)
+ *   [2]    button count
+ *   [3..]  encoder positions of every bank, bank-major, 16-bit big-endian
+ *   [..]   button states, 1 bit each, LSB first
+ *
+ * Restoring writes every value through the model setters, so a whole dump
+ * reaches the view in a single sync. A dump with other counts (and no more than
+ * BYTES) is accepted: the common controls are restored, the rest is left untouched.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace model {
+
+template <typename State>
+struct StateDump {
+    static constexpr uint8_t FORMAT_VERSION = 2;  ///< 2: values of all encoder banks
+    static constexpr size_t HEADER_BYTES = 3;
+
+    static constexpr size_t bytesFor(size_t encoders, size_t buttons) {
+        return HEADER_BYTES + encoders * 2 + (buttons + 7) / 8;
+    }
+
+    /// Payload size for this State
+    static constexpr size_t BYTES = bytesFor(State::SLOT_COUNT, State::BUTTON_COUNT);
+
+    static_assert(State::SLOT_COUNT <= 255 && State::BUTTON_COUNT <= 255,
+                  "Dump header stores counts on one byte");
+
+    /// Serialize state into out (BYTES bytes), return the size written
+    static size_t write(const State& state, uint8_t* out) {
+        uint8_t* p = out;
+        *p++ = FORMAT_VERSION;
+        *p++ = uint8_t(State::SLOT_COUNT);
+        *p++ = uint8_t(State::BUTTON_COUNT);
+
+        for (size_t i = 0; i < State::SLOT_COUNT; ++i) {
+            const uint16_t position = state.slot(i);
+            *p++ = uint8_t(position >> 8);
+            *p++ = uint8_t(position);
+        }
+
+        for (size_t i = 0; i < State::BUTTON_COUNT; i += 8) {
+            uint8_t bits = 0;
+            for (size_t b = 0; b < 8 && i + b < State::BUTTON_COUNT; ++b) {
+                bits |= uint8_t(state.button(i + b)) << b;
+            }
+            *p++ = bits;
+        }
+        return size_t(p - out);
+    }
+
+    /// Apply a dump to state, false if malformed (state untouched)
+    static bool read(const uint8_t* data, size_t size, State& state) {
+        if (size < HEADER_BYTES || data[0] != FORMAT_VERSION) return false;
+        const size_t encoders = data[1];
+        const size_t buttons = data[2];
+        if (size != bytesFor(encoders, buttons)) return false;
+
+        const uint8_t* values = data + HEADER_BYTES;
+        for (size_t i = 0; i < encoders && i < State::SLOT_COUNT; ++i) {
+            state.setSlot(i, uint16_t(values[2 * i] << 8 | values[2 * i + 1]));
+        }
+
+        const uint8_t* bits = values + encoders * 2;
+        for (size_t i = 0; i < buttons && i < State::BUTTON_COUNT; ++i) {
+            state.setButton(i, (bits[i / 8] >> (i % 8)) & 1);
+        }
+        return true;
+    }
+};
+
+}  // namespace model
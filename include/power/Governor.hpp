@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file Governor.hpp
+ * @brief Core clock lowered while the panel is idle, restored on the first activity
+ *
+ * Activity = user input (Handler: encoder turns, button edges) or an LVGL
+ * invalidation (something will be redrawn: MIDI feedback, modulation, animations).
+ * After Config::Power::IDLE_AFTER_MS without activity, update() lowers the core
+ * clock to IDLE_HZ; the next activity() restores FULL_HZ before the caller goes on,
+ * so the MIDI message of the waking input is sent at full speed.
+ *
+ * Clock domains (set_arm_clock() updates F_CPU_ACTUAL, F_BUS_ACTUAL and micros()):
+ *   - IntervalTimer (PIT) runs from the 24 MHz oscillator and LPSPI (display) from
+ *     its own PLL root: periods and SPI speed do not change
+ *   - IPG-clocked peripherals follow F_BUS_ACTUAL: the quadrature decoder input
+ *     filter is re-derived (input::QuadDecoder::retime())
+ *
+ * Wake latency: stats() keeps the time set_arm_clock() took (added to the first
+ * MIDI message) and the time from the wake to the end of the next LVGL refresh.
+ */
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#include "Config.hpp"
+#include "input/QuadDecoder.hpp"
+
+extern "C" uint32_t set_arm_clock(uint32_t frequency);
+
+namespace power {
+
+class Governor {
+public:
+    struct Stats {
+        uint32_t throttles = 0;         ///< Switches to IDLE_HZ
+        uint32_t wakes = 0;             ///< Switches back to FULL_HZ
+        uint32_t lastSwitchUs = 0;      ///< set_arm_clock() duration of the last wake
+        uint32_t maxSwitchUs = 0;
+        uint32_t lastFirstFrameUs = 0;  ///< Wake -> end of the next refresh
+        uint32_t maxFirstFrameUs = 0;
+    };
+
+    static Governor& instance() {
+        static Governor governor;
+        return governor;
+    }
+
+    /// Watch display invalidations (call after LVGL init)
+    void begin(lv_display_t* display) {
+        lastActivityMs_ = millis();
+        if (display) lv_display_add_event_cb(display, onInvalidate, LV_EVENT_INVALIDATE_AREA, this);
+    }
+
+    /// Input or redraw ahead: full speed now
+    void activity() {
+        lastActivityMs_ = millis();
+        if (!throttled_) return;
+
+        const uint32_t start = micros();
+        setClock(Config::Power::FULL_HZ);
+        throttled_ = false;
+        stats_.lastSwitchUs = micros() - start;
+        if (stats_.lastSwitchUs > stats_.maxSwitchUs) stats_.maxSwitchUs = stats_.lastSwitchUs;
+        ++stats_.wakes;
+        wakeUs_ = start;
+        framePending_ = true;
+    }
+
+    /// Throttle once idle long enough (call once per app tick)
+    void update() {
+        if (throttled_ || !Config::Power::ENABLED) return;
+        if (millis() - lastActivityMs_ < Config::Power::IDLE_AFTER_MS) return;
+        setClock(Config::Power::IDLE_HZ);
+        throttled_ = true;
+        ++stats_.throttles;
+    }
+
+    /// An LVGL refresh completed (call after each refresh)
+    void frameDone() {
+        if (!framePending_) return;
+        framePending_ = false;
+        stats_.lastFirstFrameUs = micros() - wakeUs_;
+        if (stats_.lastFirstFrameUs > stats_.maxFirstFrameUs) {
+            stats_.maxFirstFrameUs = stats_.lastFirstFrameUs;
+        }
+    }
+
+    bool throttled() const { return throttled_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    Governor() = default;
+
+    static void onInvalidate(lv_event_t* e) {
+        static_cast<Governor*>(lv_event_get_user_data(e))->activity();
+    }
+
+    static void setClock(uint32_t hz) {
+        set_arm_clock(hz);
+        input::QuadDecoder::instance().retime();
+    }
+
+    uint32_t lastActivityMs_ = 0;
+    uint32_t wakeUs_ = 0;
+    bool throttled_ = false;
+    bool framePending_ = false;
+    Stats stats_;
+};
+
+}  // namespace power
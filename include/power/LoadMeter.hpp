@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file LoadMeter.hpp
+ * @brief Tick, wakeup and busy-time accounting of power::TickClock
+ *
+ * TickClock measures (cycle counter, WFI exits, ticks due) and feeds this meter;
+ * the meter keeps the counters and publishes a Load once per window.
+ *
+ * No Arduino or Config dependency: builds on a host (test/test_tickclock).
+ */
+
+#include <cstdint>
+
+namespace power {
+
+class LoadMeter {
+public:
+    struct Stats {
+        uint32_t ticks = 0;
+        uint32_t lateTicks = 0;  ///< Ticks that came due while the previous one still ran
+        uint32_t wakeups = 0;    ///< WFI exits (any interrupt)
+    };
+
+    /// Last window
+    struct Load {
+        uint16_t idlePermille = 0;   ///< Time spent waiting for the tick
+        uint32_t wakeupsPerSec = 0;  ///< WFI exits (0 when spinning)
+        uint32_t busyUsMax = 0;      ///< Longest tick
+    };
+
+    explicit LoadMeter(uint32_t windowUs = 1'000'000) : windowUs_(windowUs) {}
+
+    /// Open the first window
+    void start(uint32_t nowUs) { windowStartUs_ = nowUs; }
+
+    /// One tick's work took `us`
+    void busy(uint32_t us) {
+        busyUs_ += us;
+        if (us > busyUsMax_) busyUsMax_ = us;
+    }
+
+    /// The core left WFI
+    void wakeup() {
+        ++stats_.wakeups;
+        ++windowWakeups_;
+    }
+
+    /// `due` ticks elapsed since the last wait (more than 1: late)
+    void ticks(uint32_t due) {
+        stats_.ticks += due;
+        if (due > 1) stats_.lateTicks += due - 1;
+    }
+
+    /// Publish load() once the window has elapsed; true when published
+    bool close(uint32_t nowUs) {
+        const uint32_t elapsedUs = nowUs - windowStartUs_;
+        if (elapsedUs < windowUs_) return false;
+
+        load_.idlePermille =
+            uint16_t(busyUs_ >= elapsedUs ? 0 : 1000 - busyUs_ * 1000ull / elapsedUs);
+        load_.wakeupsPerSec = uint32_t(windowWakeups_ * 1'000'000ull / elapsedUs);
+        load_.busyUsMax = busyUsMax_;
+
+        windowStartUs_ += elapsedUs;
+        busyUs_ = 0;
+        busyUsMax_ = 0;
+        windowWakeups_ = 0;
+        return true;
+    }
+
+    const Stats& stats() const { return stats_; }
+    const Load& load() const { return load_; }
+
+private:
+    uint32_t windowUs_;
+    uint32_t windowStartUs_ = 0;
+    uint32_t busyUs_ = 0;  ///< In the current window
+    uint32_t busyUsMax_ = 0;
+    uint32_t windowWakeups_ = 0;
+    Stats stats_;
+    Load load_;
+};
+
+}  // namespace power
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file TickClock.hpp
+ * @brief App tick at APP_HZ from a timer interrupt, core asleep (WFI) in between
+ *
+ * loop() calls wait() first: it returns once a tick is due. In between, the core
+ * executes WFI and is woken by any interrupt (tick timer, SysTick, USB, display
+ * DMA, scan and capture timers); those ISRs do their work and the core goes back
+ * to sleep unless the tick is due. With Config::Timing::SLEEP_WHEN_IDLE = false,
+ * wait() spins on micros() instead (previous behaviour, for comparison).
+ *
+ * Load (current draw proxies): busy time is measured with the cycle counter from
+ * each tick to the next wait() (converted at the current F_CPU_ACTUAL, see
+ * power::Governor); idle = 1 - busy / elapsed, and wakeups counts WFI exits. Both
+ * are published once per second by load() (power::LoadMeter). test/test_tickclock
+ * runs this loop against simulated interrupt sources and counts the wakeups.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "power/LoadMeter.hpp"
+
+namespace power {
+
+class TickClock {
+public:
+    static constexpr uint32_t PERIOD_US = 1'000'000 / Config::Timing::APP_HZ;
+
+    using Stats = LoadMeter::Stats;
+    using Load = LoadMeter::Load;  ///< Last one-second window
+
+    static TickClock& instance() {
+        static TickClock clock;
+        return clock;
+    }
+
+    /// Start the tick timer
+    void begin() {
+        lastTickUs_ = micros();
+        meter_.start(lastTickUs_);
+        busyStart_ = ARM_DWT_CYCCNT;
+        if (!Config::Timing::SLEEP_WHEN_IDLE) return;
+        timer_.begin(onTick, PERIOD_US);
+        timer_.priority(Config::Timing::TICK_PRIORITY);
+    }
+
+    /// Block until the next tick is due (WFI or spin); returns ticks elapsed (>= 1)
+    uint32_t wait() {
+        const uint32_t busyUs = (ARM_DWT_CYCCNT - busyStart_) / (F_CPU_ACTUAL / 1'000'000);
+        meter_.busy(busyUs);
+
+        const uint32_t due = Config::Timing::SLEEP_WHEN_IDLE ? sleep() : spin();
+        busyStart_ = ARM_DWT_CYCCNT;
+
+        meter_.ticks(due);
+        meter_.close(micros());
+        return due;
+    }
+
+    const Stats& stats() const { return meter_.stats(); }
+    const Load& load() const { return meter_.load(); }
+
+private:
+    TickClock() = default;
+
+    static void onTick() { ++instance().pending_; }
+
+    /// Sleep until the tick ISR ran. Interrupts are masked around the check so a
+    /// tick between the check and WFI still wakes the core (WFI ignores PRIMASK)
+    uint32_t sleep() {
+        while (true) {
+            __disable_irq();
+            const uint32_t pending = pending_;
+            if (pending) {
+                pending_ = 0;
+                __enable_irq();
+                return pending;
+            }
+            asm volatile("wfi");
+            __enable_irq();  // The waking ISR runs here
+            meter_.wakeup();
+        }
+    }
+
+    uint32_t spin() {
+        uint32_t now;
+        while ((now = micros()) - lastTickUs_ < PERIOD_US) {}
+        const uint32_t due = (now - lastTickUs_) / PERIOD_US;
+        lastTickUs_ += due * PERIOD_US;
+        return due;
+    }
+
+    IntervalTimer timer_;
+    volatile uint32_t pending_ = 0;  ///< Ticks due, written by the tick ISR
+    uint32_t lastTickUs_ = 0;        ///< Spin mode
+    uint32_t busyStart_ = 0;
+    LoadMeter meter_;
+};
+
+}  // namespace power
@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * @file FrameBudget.hpp
+ * @brief Per-frame render budget: deferrable redraws held back after an overrun
+ *
+ * A frame blocks the loop while LVGL renders it: app ticks (input polling, MIDI
+ * out) wait until it is done, and the mux/matrix scan queues fill meanwhile. The
+ * render of each frame (REFR_START -> RENDER_READY) is measured against BUDGET_US:
+ *
+ *   - within budget: everything dirty is drawn
+ *   - after a frame over budget (degraded): urgent updates (local input, bank switch,
+ *     buttons) are always applied; deferrable ones (MIDI feedback, state restores)
+ *     are admitted while the predicted render (cost per update, learned) fits, at
+ *     least one per frame; the rest stays dirty. Animation steps are held. Degraded
+ *     ends with a frame within budget that deferred no update
+ *
+ * Titles and widget labels are static (pre-rasterized) and only drawn with the
+ * areas invalidated around them, so they need no deferral of their own.
+ *
+ * MIDI produced by a tick is flushed before the frame starts (main loop), so a long
+ * render delays the next input tick but never the MIDI of the previous one.
+ *
+ * BUDGET_US = Config::LVGL::RENDER_BUDGET_US, lowered to what the active scan
+ * queues buffer minus one app tick (INPUT_DEADLINE_US): a frame within budget never
+ * makes a scanner drop a frame.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <lvgl.h>
+
+namespace ui {
+
+namespace detail {
+
+constexpr uint32_t scanQueueSpanUs(size_t lines, size_t steps, uint32_t stepUs, size_t queue) {
+    return lines ? uint32_t(steps * stepUs * queue) : UINT32_MAX;
+}
+
+}  // namespace detail
+
+class FrameBudget {
+public:
+    /// Longest a frame may block the app tick before a scan queue overflows (UINT32_MAX:
+    /// no scanner)
+    static constexpr uint32_t INPUT_DEADLINE_US =
+        std::min(detail::scanQueueSpanUs(Config::Button::Mux::SIGNAL_PINS.size(), 16,
+                                         Config::Button::Mux::STEP_US,
+                                         Config::Button::Mux::FRAME_QUEUE),
+                 detail::scanQueueSpanUs(Config::Button::Matrix::COL_PINS.size(),
+                                         Config::Button::Matrix::ROW_PINS.size(),
+                                         Config::Button::Matrix::STEP_US,
+                                         Config::Button::Matrix::FRAME_QUEUE));
+    static constexpr uint32_t TICK_US = 1'000'000 / Config::Timing::APP_HZ;
+    static constexpr uint32_t BUDGET_US =
+        std::min(Config::LVGL::RENDER_BUDGET_US,
+                 INPUT_DEADLINE_US > TICK_US ? INPUT_DEADLINE_US - TICK_US : 0);
+    static_assert(BUDGET_US >= 1000,
+                  "Scan queues too short for a frame: raise FRAME_QUEUE or STEP_US");
+
+    struct Stats {
+        uint32_t frames = 0;              ///< Rendered frames
+        uint32_t overruns = 0;            ///< Render over BUDGET_US
+        uint32_t deadlineMisses = 0;      ///< Render over INPUT_DEADLINE_US (scan frames lost)
+        uint32_t degradedFrames = 0;      ///< Frames rendered after an overrun
+        uint32_t deferredUpdates = 0;     ///< Deferrable updates held for a later frame
+        uint32_t deferredAnimations = 0;  ///< Animation steps held
+        uint32_t lastRenderUs = 0;
+        uint32_t maxRenderUs = 0;
+        uint32_t updateCostUs = 0;        ///< Learned render cost per widget update
+    };
+
+    static FrameBudget& instance() {
+        static FrameBudget budget;
+        return budget;
+    }
+
+    /// Measure the renders of `display` (call after LVGL init)
+    void begin(lv_display_t* display) {
+        lv_display_add_event_cb(display, onEvent, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, onEvent, LV_EVENT_RENDER_READY, this);
+    }
+
+    /// The previous frame overran: deferrable work is rationed
+    bool degraded() const { return degraded_; }
+
+    /// A widget update applied in the current frame (urgent or admitted)
+    void spend() { ++updates_; }
+
+    /// Deferrable widget update: true = apply it (then spend()), false = keep it for a
+    /// later frame
+    bool admit() {
+        if (!degraded_ || !admitted_ || (updates_ + 1) * costUs_ <= BUDGET_US) {
+            admitted_ = true;
+            return true;
+        }
+        ++stats_.deferredUpdates;
+        deferred_ = true;
+        return false;
+    }
+
+    /// Animation step: false = hold it this frame (time-based animations catch up)
+    bool animate() {
+        if (!degraded_) return true;
+        ++stats_.deferredAnimations;
+        return false;
+    }
+
+    /// A frame rendered `updates` widget updates in renderUs (call once per render)
+    void frame(uint32_t renderUs, uint32_t updates) {
+        ++stats_.frames;
+        if (degraded_) ++stats_.degradedFrames;
+        stats_.lastRenderUs = renderUs;
+        stats_.maxRenderUs = std::max(stats_.maxRenderUs, renderUs);
+        if (renderUs > INPUT_DEADLINE_US) ++stats_.deadlineMisses;
+
+        // Cost per update includes the fixed part of a frame: conservative for few updates
+        if (updates) {
+            const int32_t cost = int32_t(renderUs / updates);
+            costUs_ = uint32_t(int32_t(costUs_) + (cost - int32_t(costUs_)) / 8);
+            stats_.updateCostUs = costUs_;
+        }
+
+        const bool overrun = renderUs > BUDGET_US;
+        if (overrun) ++stats_.overruns;
+        degraded_ = overrun || (degraded_ && deferred_);
+        updates_ = 0;
+        admitted_ = false;
+        deferred_ = false;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    FrameBudget() = default;
+
+    /// Counters are reset at RENDER_READY: view syncs (also on REFR_START) may run
+    /// before or after this handler
+    static void onEvent(lv_event_t* e) {
+        auto* self = static_cast<FrameBudget*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+            self->startUs_ = micros();
+            return;
+        }
+        self->frame(micros() - self->startUs_, self->updates_);
+    }
+
+    uint32_t startUs_ = 0;
+    uint32_t updates_ = 0;  ///< Widget updates of the current frame
+    uint32_t costUs_ = 0;
+    bool degraded_ = false;
+    bool admitted_ = false;  ///< A deferrable update was admitted in the current frame
+    bool deferred_ = false;  ///< An update was held back in the current frame
+    Stats stats_;
+};
+
+}  // namespace ui
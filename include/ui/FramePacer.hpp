@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file FramePacer.hpp
+ * @brief LVGL frames paced on the panel's measured refresh, each finished before its vsync
+ *
+ * The ILI9341 scans from its own oscillator: its real refresh rate differs per unit
+ * from Config::Display::CONFIG.refreshRate. The driver holds a flush while the
+ * previous frame still waits for its vsync, so frames started every 1/LVGL_HZ on
+ * the MCU clock beat against the panel: the loop blocks in held flushes, frames are
+ * shown a refresh late, or some refreshes show no new frame.
+ *
+ *   - calibrate() (boot): CALIBRATION_FRAMES back-to-back frames. Each flush is
+ *     held until a vsync, so flush ends are vsync + copy time: their spacing gives
+ *     the frame period (least squares), the shortest flush the copy time. The first
+ *     flushes find nothing queued and are not held: they are left out
+ *   - due() / render() (loop): a frame starts at its target vsync - (frame cost +
+ *     FRAME_MARGIN_US). Frame cost = render + copy, mean + 4 deviations
+ *   - held flushes are phase measurements (vsync = end - copy time): every
+ *     PROBE_FRAMES rendered frames the next frame is rendered right away, a period
+ *     early, to get one. The phase and period follow the error (panel/MCU clock drift)
+ *
+ * A probe invalidates a pixel to have something to flush, which is activity for
+ * power::Governor. It only follows a frame that rendered (the panel is being
+ * redrawn anyway), so an idle panel gets no probe and the core clock can drop. After
+ * a long idle period the phase may be off: the first held flush relocks it.
+ *
+ * A frame that misses its vsync leaves one frame queued in the driver, so the next
+ * one would be held too: a held flush re-targets the schedule after that frame.
+ *
+ * LVGL's refresh timer is paused: frames are rendered by render() only. The pacing
+ * math (lock(), frame(), observe(), advance()) is ui::FrameSchedule, arithmetic on
+ * micros() timestamps; test/test_framepacer runs it against a simulated panel.
+ * Panel period changes up to about 0.1 % are followed; larger steps relock the phase
+ * at each probe without correcting the period.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "ui/FrameSchedule.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include <lvgl.h>
+
+namespace ui {
+
+class FramePacer {
+public:
+    static constexpr size_t CALIBRATION_FRAMES = Config::LVGL::CALIBRATION_FRAMES;
+
+    using Schedule = FrameSchedule<CALIBRATION_FRAMES>;
+    using Stats = Schedule::Stats;
+
+    static FramePacer& instance() {
+        static FramePacer pacer;
+        return pacer;
+    }
+
+    /// Take over the refreshes of `display` (call after LVGL init)
+    void begin(lv_display_t* display) {
+        display_ = display;
+        lv_display_add_event_cb(display, onEvent, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, onEvent, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(display, onEvent, LV_EVENT_REFR_READY, this);
+        if (lv_timer_t* timer = lv_display_get_refr_timer(display)) lv_timer_pause(timer);
+    }
+
+    /// Measure the frame period (blocks for CALIBRATION_FRAMES refreshes)
+    bool calibrate() {
+        std::array<uint32_t, CALIBRATION_FRAMES> ends{};
+        std::array<uint32_t, CALIBRATION_FRAMES> flushes{};
+        uint32_t renderMax = 0;
+        for (size_t i = 0; i < CALIBRATION_FRAMES; ++i) {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(display_);
+            ends[i] = endUs_;
+            flushes[i] = endUs_ - renderUs_;
+            renderMax = std::max(renderMax, renderUs_ - startUs_);
+        }
+        return schedule_.calibrate(ends.data(), flushes.data(), CALIBRATION_FRAMES, renderMax,
+                                   micros());
+    }
+
+    /// Time to start a frame (call every app tick)
+    bool due(uint32_t nowUs) const { return schedule_.due(nowUs); }
+
+    /// Run LVGL (refresh: the bridge's timer handler) and render the frame
+    template <typename Refresh>
+    void render(Refresh&& refresh) {
+        const uint32_t slot = schedule_.slotUs();
+        rendered_ = false;
+        refresh();
+        lv_refr_now(display_);
+        if (rendered_) {
+            if (schedule_.frame(slot, startUs_, renderUs_, endUs_)) schedule_.observe(endUs_);
+            if (++sinceProbe_ >= Config::LVGL::PROBE_FRAMES) probe();
+        }
+        schedule_.advance(micros());
+    }
+
+    const Stats& stats() const { return schedule_.stats(); }
+    void resetStats() { schedule_.resetStats(); }
+
+private:
+    static constexpr double NOMINAL_US =
+        1e6 * Config::Display::CONFIG.vsyncSpacing / Config::Display::CONFIG.refreshRate;
+
+    FramePacer() = default;
+
+    /// Render the next frame now: its flush is held until the current frame's vsync
+    void probe() {
+        sinceProbe_ = 0;
+        const lv_area_t pixel = {0, 0, 0, 0};
+        lv_obj_invalidate_area(lv_screen_active(), &pixel);  // Something to flush
+        rendered_ = false;
+        lv_refr_now(display_);
+        if (rendered_) schedule_.probe(renderUs_, endUs_);
+    }
+
+    static void onEvent(lv_event_t* e) {
+        auto* self = static_cast<FramePacer*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+            case LV_EVENT_REFR_START: self->startUs_ = micros(); break;
+            case LV_EVENT_RENDER_READY:
+                self->renderUs_ = micros();
+                self->rendered_ = true;
+                break;
+            case LV_EVENT_REFR_READY: self->endUs_ = micros(); break;
+            default: break;
+        }
+    }
+
+    lv_display_t* display_ = nullptr;
+    Schedule schedule_{{NOMINAL_US, Config::LVGL::FRAME_MARGIN_US}};
+    uint32_t sinceProbe_ = 0;  ///< Rendered frames since the last probe
+    uint32_t startUs_ = 0;   ///< REFR_START
+    uint32_t renderUs_ = 0;  ///< RENDER_READY
+    uint32_t endUs_ = 0;     ///< REFR_READY
+    bool rendered_ = false;
+};
+
+}  // namespace ui
@@ -0,0 +1,217 @@
+#pragma once
+
+/**
+ * @file FrameSchedule.hpp
+ * @brief Timing core of ui::FramePacer: panel period and phase, frame cost, frame slots
+ *
+ * Arithmetic on microsecond timestamps only: FramePacer takes them around LVGL's
+ * refreshes (REFR_START, RENDER_READY, REFR_READY) and feeds them here.
+ *
+ * No Arduino, LVGL or Config dependency: builds on a host (test/test_framepacer).
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace ui {
+
+/// Pacing settings (Config::Display / Config::LVGL values in FramePacer)
+struct FrameTiming {
+    double nominalUs;   ///< Panel refresh period from the configured refresh rate
+    uint32_t marginUs;  ///< Frame finished this long before its vsync
+};
+
+/**
+ * @brief Frame period and phase from held flushes, frame slots from the frame cost
+ *
+ * @tparam CalibrationFrames Most flush ends given to calibrate() / lock()
+ */
+template <size_t CalibrationFrames>
+class FrameSchedule {
+public:
+    struct Stats {
+        uint32_t frames = 0;       ///< Rendered frames
+        uint32_t missed = 0;       ///< Flush ended after the target vsync (shown a refresh late)
+        uint32_t late = 0;         ///< Started after the slot + FRAME_MARGIN_US
+        uint32_t skipped = 0;      ///< Slots passed without a frame (loop busy)
+        uint32_t held = 0;         ///< Regular frames whose flush was held
+        uint32_t probes = 0;       ///< Frames rendered early for a phase measurement
+        uint32_t relocks = 0;      ///< Phase measurements off by more than a quarter period
+        uint32_t periodUs = 0;     ///< Frame period in use
+        uint32_t jitterUs = 0;     ///< Mean |start - slot|
+        uint32_t maxJitterUs = 0;  ///< Since the last resetStats()
+        uint32_t costUs = 0;       ///< Frame cost budget (render + copy)
+        bool calibrated = false;   ///< false: nominal period (calibration rejected)
+    };
+
+    explicit FrameSchedule(const FrameTiming& timing)
+        : timing_(timing), period_(timing.nominalUs) {}
+
+    /// Lock on back-to-back frames (flush ends, flush times, longest render) and target
+    /// the first slot after nowUs
+    bool calibrate(const uint32_t* ends, const uint32_t* flushes, size_t n, uint32_t renderMaxUs,
+                   uint32_t nowUs) {
+        const bool locked = lock(ends, flushes, n);
+
+        // Full-screen renders: a safe first budget, refined by frame()
+        costMeanUs_ = renderMaxUs + copyUs_;
+        costDevUs_ = 0;
+        stats_.costUs = costUs();
+        shift(period_);  // The last calibration frame is shown at this vsync
+        advance(nowUs);
+        stats_.skipped = 0;
+        return locked;
+    }
+
+    /// Period and phase from held flushes (ends[i] = vsync + copy time). The first
+    /// flushes are not held (nothing queued yet) and are left out. false and nominal
+    /// period if fewer than 4 were held or the spacing is off by more than 20% (no vsync
+    /// in the driver)
+    bool lock(const uint32_t* ends, const uint32_t* flushes, size_t n) {
+        const double nominalUs = timing_.nominalUs;
+        period_ = nominalUs;
+        copyUs_ = *std::min_element(flushes, flushes + n);
+        stats_.calibrated = false;
+        size_t first = 0;
+        while (first < n && flushes[first] <= copyUs_ + HELD_US) ++first;
+        if (n - first < 4) return relock(ends[n - 1]);
+
+        std::array<uint32_t, CalibrationFrames> spacing{};
+        const size_t m = std::min(n - 1 - first, spacing.size());
+        for (size_t i = 0; i < m; ++i) spacing[i] = ends[first + i + 1] - ends[first + i];
+        std::sort(spacing.begin(), spacing.begin() + m);
+        const double median = spacing[m / 2];
+        if (std::fabs(median - nominalUs) > nominalUs * CALIBRATION_TOLERANCE) {
+            return relock(ends[n - 1]);
+        }
+
+        // Least squares of end time vs vsync index, from the first held frame
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (size_t i = first; i < n; ++i) {
+            const double y = double(ends[i] - ends[first]);
+            const double x = std::round(y / median);
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        const double count = double(n - first);
+        const double det = count * sxx - sx * sx;
+        period_ = det > 0 ? (count * sxy - sx * sy) / det : median;
+        stats_.calibrated = true;
+        return relock(ends[n - 1]);
+    }
+
+    /// Time to start a frame
+    bool due(uint32_t nowUs) const { return int32_t(nowUs - slotUs()) >= 0; }
+
+    /// Start time of the next frame: target vsync - (frame cost + margin)
+    uint32_t slotUs() const { return vsyncUs_ - costUs() - timing_.marginUs; }
+
+    /// Record a frame started for `slot`; true if its flush was held
+    bool frame(uint32_t slot, uint32_t startUs, uint32_t renderUs, uint32_t endUs) {
+        ++stats_.frames;
+        const int32_t delay = int32_t(startUs - slot);
+        const uint32_t jitter = uint32_t(delay < 0 ? -delay : delay);
+        stats_.jitterUs += (int32_t(jitter) - int32_t(stats_.jitterUs)) / 16;
+        stats_.maxJitterUs = std::max(stats_.maxJitterUs, jitter);
+        if (delay > int32_t(timing_.marginUs)) ++stats_.late;
+        if (int32_t(endUs - vsyncUs_) > 0) ++stats_.missed;
+
+        const uint32_t flush = endUs - renderUs;
+        copyUs_ = std::min(copyUs_, flush);
+        const bool held = flush > copyUs_ + HELD_US;
+        if (held) ++stats_.held;
+
+        // Budget: mean + 4 mean deviations of render + copy (a held flush counts as copy)
+        const int32_t cost = int32_t(renderUs - startUs + (held ? copyUs_ : flush));
+        const int32_t error = cost - int32_t(costMeanUs_);
+        costMeanUs_ = uint32_t(int32_t(costMeanUs_) + error / 8);
+        costDevUs_ = uint32_t(int32_t(costDevUs_) + (std::abs(error) - int32_t(costDevUs_)) / 4);
+        stats_.costUs = costUs();
+        return held;
+    }
+
+    /// Record a frame rendered a period early; its flush, if held, is a phase measurement
+    void probe(uint32_t renderUs, uint32_t endUs) {
+        ++stats_.frames;
+        ++stats_.probes;
+        if (endUs - renderUs > copyUs_ + HELD_US) observe(endUs);
+    }
+
+    /// Held flush ended at endUs: vsync = endUs - copy time. Corrects phase and
+    /// period, then targets the vsync after it (the held frame is shown there)
+    void observe(uint32_t endUs) {
+        const double offset = double(int32_t(endUs - copyUs_ - vsyncUs_)) - vsyncFrac_;
+        const double vsyncs = std::round(offset / period_);  // -1: probe, 0: after a miss
+        const double error = offset - vsyncs * period_;
+        if (std::fabs(error) > period_ / 4) {
+            ++stats_.relocks;
+            relock(endUs);
+            shift(period_);
+            return;
+        }
+        period_ += PERIOD_GAIN * error / std::max<uint32_t>(framesSinceObserve_, 1);
+        framesSinceObserve_ = 0;
+        shift((vsyncs + 1) * period_ + PHASE_GAIN * error);
+        stats_.periodUs = uint32_t(period_ + 0.5);
+    }
+
+    /// Target the next vsync whose slot is not past nowUs
+    void advance(uint32_t nowUs) {
+        shift(period_);
+        while (int32_t(nowUs - slotUs()) > 0) {
+            shift(period_);
+            ++stats_.skipped;
+        }
+    }
+
+    /// Target vsync of the next frame
+    uint32_t vsyncUs() const { return vsyncUs_; }
+    double periodUs() const { return period_; }
+
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_.maxJitterUs = 0; }
+
+private:
+    static constexpr double CALIBRATION_TOLERANCE = 0.2;
+    static constexpr uint32_t HELD_US = 300;  ///< Flush longer than copy + this: held
+    static constexpr double PHASE_GAIN = 0.5;
+    static constexpr double PERIOD_GAIN = 0.25;
+
+    uint32_t costUs() const { return costMeanUs_ + 4 * costDevUs_; }
+
+    /// Phase from a held flush end
+    bool relock(uint32_t endUs) {
+        vsyncUs_ = endUs - copyUs_;
+        vsyncFrac_ = 0.0;
+        framesSinceObserve_ = 0;
+        stats_.periodUs = uint32_t(period_ + 0.5);
+        return stats_.calibrated;
+    }
+
+    /// vsyncUs_ += us, keeping the fraction
+    void shift(double us) {
+        vsyncFrac_ += us;
+        const double whole = std::floor(vsyncFrac_);
+        vsyncUs_ += uint32_t(int32_t(whole));
+        vsyncFrac_ -= whole;
+        ++framesSinceObserve_;
+    }
+
+    FrameTiming timing_;
+    double period_;
+    double vsyncFrac_ = 0.0;  ///< Fraction of a us of vsyncUs_
+    uint32_t vsyncUs_ = 0;    ///< Target vsync of the next frame
+    uint32_t copyUs_ = 0;     ///< Flush time when not held (calibrate())
+    uint32_t costMeanUs_ = 0;
+    uint32_t costDevUs_ = 0;
+    uint32_t framesSinceObserve_ = 0;
+    Stats stats_;
+};
+
+}  // namespace ui
@@ -0,0 +1,137 @@
+#pragma once
+
+/**
+ * @file Smoother.hpp
+ * @brief Displayed encoder values gliding to their model values, one pass per frame
+ *
+ * One channel (value, velocity, target) per encoder in a fixed array: setting a
+ * target allocates nothing and starts no lv_anim_t. step() advances every moving
+ * channel once per frame by the time elapsed since the previous step, with the exact
+ * solution of the motion, so the glide does not depend on the frame rate:
+ *
+ *   - SPRING (critically damped): e(t) = (e0 + (v0 + w e0) t) exp(-w t), no overshoot
+ *   - EXPONENTIAL (first order):  e(t) = e0 exp(-w t)
+ *   - OFF: the value jumps to the target
+ *
+ * w = 1 / Config::LVGL::SMOOTHING_MS. A channel within SETTLE of its target (and
+ * slow enough, for the spring) snaps to it and stops moving. The first step after
+ * an idle period uses the previous step's duration, not the idle time.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+#include "model/ControlState.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * @tparam N Channels (encoders)
+ */
+template <size_t N>
+class Smoother {
+public:
+    using Mode = Config::LVGL::Smoothing;
+
+    static constexpr Mode MODE = Config::LVGL::SMOOTHING;
+    static constexpr float OMEGA = 1000.0f / Config::LVGL::SMOOTHING_MS;  ///< Per second
+    static constexpr float SETTLE = model::POSITION_MAX / 2048.0f;  ///< Well under a pixel
+    static constexpr float MAX_STEP_S = 0.1f;  ///< Longer gaps (held steps) are cut to this
+
+    struct Stats {
+        uint32_t steps = 0;    ///< Passes that moved at least one channel
+        uint32_t updates = 0;  ///< Displayed values changed
+        uint32_t lastStepUs = 0;
+    };
+
+    /// New value to glide to
+    void setTarget(size_t i, int32_t target) {
+        Channel& ch = channels_[i];
+        ch.target = float(target);
+        if (MODE == Mode::OFF) ch.value = ch.target;
+        moving_.set(i);
+    }
+
+    /// Show `value` at once (bank switch, new widgets, frame over budget): the caller
+    /// publishes it
+    void snap(size_t i, int32_t value) {
+        channels_[i] = {float(value), 0.0f, float(value), value};
+        moving_.reset(i);
+    }
+
+    bool active() const { return moving_.any(); }
+
+    /// Advance every moving channel to nowUs; fn(i, value) for each displayed change
+    template <typename Fn>
+    void step(uint32_t nowUs, Fn&& fn) {
+        const float elapsed = std::fmin(float(nowUs - lastUs_) * 1e-6f, MAX_STEP_S);
+        lastUs_ = nowUs;
+        if (!moving_.any()) {
+            idle_ = true;
+            return;
+        }
+        const float dt = idle_ ? lastDt_ : elapsed;
+        lastDt_ = dt;
+        idle_ = false;
+
+        const uint32_t start = micros();
+        const float decay = std::exp(-OMEGA * dt);
+        model::DirtyBits<N> still;
+
+        moving_.consume([&](size_t i) {
+            Channel& ch = channels_[i];
+            const float error = ch.value - ch.target;
+            if (MODE == Mode::SPRING) {
+                const float drive = ch.velocity + OMEGA * error;
+                ch.value = ch.target + (error + drive * dt) * decay;
+                ch.velocity = (ch.velocity - OMEGA * drive * dt) * decay;
+            } else if (MODE == Mode::EXPONENTIAL) {
+                ch.value = ch.target + error * decay;
+            }
+
+            const bool settled = std::fabs(ch.value - ch.target) < SETTLE &&
+                                 std::fabs(ch.velocity) * dt < SETTLE;
+            if (settled) {
+                ch.value = ch.target;
+                ch.velocity = 0.0f;
+            } else {
+                still.set(i);
+            }
+
+            const int32_t shown = int32_t(std::lround(ch.value));
+            if (shown == ch.shown) return;
+            ch.shown = shown;
+            ++stats_.updates;
+            fn(i, shown);
+        });
+        moving_ = still;
+        idle_ = !moving_.any();
+
+        ++stats_.steps;
+        stats_.lastStepUs = micros() - start;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Channel {
+        float value = 0.0f;
+        float velocity = 0.0f;  ///< Position units per second (SPRING)
+        float target = 0.0f;
+        int32_t shown = -1;     ///< Last value handed out
+    };
+
+    std::array<Channel, N> channels_{};
+    model::DirtyBits<N> moving_;
+    uint32_t lastUs_ = 0;
+    float lastDt_ = 1.0f / Config::Timing::LVGL_HZ;
+    bool idle_ = true;  ///< Nothing moved at the last step
+    Stats stats_;
+};
+
+}  // namespace ui
@@ -0,0 +1,350 @@
+#pragma once
+
+/**
+ * @file LabelCache.hpp
+ * @brief Pre-rasterized bitmaps for static label text
+ *
+ * Static texts ("Open Control", "ENC 1", "BTN 1"...) are rasterized once into
+ * RGB565A8 images (color plane + A8 coverage plane), then blitted on every redraw
+ * instead of looking up, clipping and blending each font glyph again.
+ *
+ * Memory is capped by Config::LVGL::LABEL_CACHE_BYTES. Unused bitmaps stay cached
+ * (views re-created on context switch hit them) until evicted least-recently-used.
+ * Bitmaps still shown by a widget are pinned and never evicted.
+ *
+ * Saving report: on a miss, the text is also drawn once as glyphs and once as the
+ * cached bitmap into an RGB565 scratch canvas (like the screen); the difference is
+ * what each later draw of that label saves. Draws are counted per rendered frame
+ * (begin() hooks LV_EVENT_REFR_READY), see Stats::frameSavedUs.
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include <lvgl.h>
+
+namespace ui {
+
+/**
+ * @brief Fixed-slot LRU cache of rasterized label bitmaps
+ *
+ * Key: (text, font, color). acquire() pins an entry, release() unpins it.
+ * Returns nullptr when the bitmap cannot fit; callers fall back to lv_label.
+ */
+class LabelCache {
+public:
+    static constexpr size_t MAX_ENTRIES = 16;
+
+    struct Stats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        uint32_t rejected = 0;  ///< Did not fit in the budget
+        uint32_t rasterUs = 0;  ///< Total time spent rasterizing (misses)
+        size_t bytesUsed = 0;
+        uint32_t frameDraws = 0;       ///< Cached labels drawn by the last frame drawing any
+        uint32_t frameSavedUs = 0;     ///< Glyph render time they saved
+        uint32_t maxFrameSavedUs = 0;  ///< Most saved by one frame (a full redraw)
+
+        /// Mean time to rasterize a missed label (glyphs into the A8 coverage plane)
+        uint32_t meanRasterUs() const { return misses ? rasterUs / misses : 0; }
+    };
+
+    static LabelCache& instance() {
+        static LabelCache cache(Config::LVGL::LABEL_CACHE_BYTES);
+        return cache;
+    }
+
+    explicit LabelCache(size_t budgetBytes) : budget_(budgetBytes) {}
+    ~LabelCache() {
+        for (auto& entry : entries_) drop(entry);
+    }
+
+    LabelCache(const LabelCache&) = delete;
+    LabelCache& operator=(const LabelCache&) = delete;
+
+    /// Count saved glyph render time per frame of this display (call after LVGL init)
+    void begin(lv_display_t* display) {
+        lv_display_add_event_cb(display, onRefreshReady, LV_EVENT_REFR_READY, this);
+    }
+
+    /// Get (rasterizing on miss) and pin the bitmap for a text
+    const lv_draw_buf_t* acquire(const char* text, const lv_font_t* font, lv_color_t color) {
+        ++clock_;
+        if (Entry* entry = find(text, font, color)) {
+            ++stats_.hits;
+            ++entry->refs;
+            entry->lastUse = clock_;
+            return &entry->image;
+        }
+
+        lv_point_t size;
+        lv_text_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+        if (size.x <= 0 || size.y <= 0) return nullptr;
+
+        const uint32_t stride = lv_draw_buf_width_to_stride(size.x, LV_COLOR_FORMAT_RGB565);
+        const size_t bytes = size_t(stride) * size.y + size_t(stride / 2) * size.y;
+        Entry* slot = makeRoom(bytes);
+        if (!slot) {
+            ++stats_.rejected;
+            return nullptr;
+        }
+
+        const uint32_t start = micros();
+        if (!rasterize(*slot, text, font, color, size, stride, bytes)) return nullptr;
+        stats_.rasterUs += micros() - start;
+        ++stats_.misses;
+        slot->savedUs = measureSaving(slot->image, text, font, color, size);
+
+        slot->text = text;
+        slot->font = font;
+        slot->color = color;
+        slot->refs = 1;
+        slot->lastUse = clock_;
+        stats_.bytesUsed += bytes;
+        return &slot->image;
+    }
+
+    /// Unpin a bitmap returned by acquire(); it stays cached until evicted
+    void release(const lv_draw_buf_t* image) {
+        for (auto& entry : entries_) {
+            if (&entry.image == image && entry.refs > 0) {
+                --entry.refs;
+                return;
+            }
+        }
+    }
+
+    /// A cached bitmap was drawn (once per draw, by whoever blits it)
+    void drawn(const lv_draw_buf_t* image) {
+        for (const auto& entry : entries_) {
+            if (&entry.image == image) {
+                ++pendingDraws_;
+                pendingSavedUs_ += entry.savedUs;
+                return;
+            }
+        }
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        std::string text;
+        const lv_font_t* font = nullptr;
+        lv_color_t color{};
+        lv_draw_buf_t image{};
+        uint8_t* data = nullptr;
+        size_t bytes = 0;
+        uint32_t lastUse = 0;
+        uint32_t savedUs = 0;  ///< Glyph render minus blit time, per draw
+        uint16_t refs = 0;
+    };
+
+    /// Close a rendered frame: report what its cached label draws saved
+    static void onRefreshReady(lv_event_t* e) {
+        auto* self = static_cast<LabelCache*>(lv_event_get_user_data(e));
+        if (self->pendingDraws_ == 0) return;  // Keep the figures of the last frame drawing any
+        Stats& stats = self->stats_;
+        stats.frameDraws = self->pendingDraws_;
+        stats.frameSavedUs = self->pendingSavedUs_;
+        if (stats.frameSavedUs > stats.maxFrameSavedUs) stats.maxFrameSavedUs = stats.frameSavedUs;
+        self->pendingDraws_ = 0;
+        self->pendingSavedUs_ = 0;
+    }
+
+    Entry* find(const char* text, const lv_font_t* font, lv_color_t color) {
+        for (auto& entry : entries_) {
+            if (entry.data && entry.font == font && lv_color_eq(entry.color, color) &&
+                entry.text == text) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Evict unpinned entries (LRU first) until `bytes` fit, return a free slot
+    Entry* makeRoom(size_t bytes) {
+        if (bytes > budget_) return nullptr;
+
+        while (true) {
+            Entry* freeSlot = nullptr;
+            Entry* victim = nullptr;
+            for (auto& entry : entries_) {
+                if (!entry.data) {
+                    if (!freeSlot) freeSlot = &entry;
+                } else if (entry.refs == 0 && (!victim || entry.lastUse < victim->lastUse)) {
+                    victim = &entry;
+                }
+            }
+            if (freeSlot && stats_.bytesUsed + bytes <= budget_) return freeSlot;
+            if (!victim) return nullptr;
+            drop(*victim);
+            ++stats_.evictions;
+        }
+    }
+
+    void drop(Entry& entry) {
+        if (!entry.data) return;
+        // LVGL caches decoded images by source pointer: forget this one before reuse
+        lv_image_cache_drop(&entry.image);
+        lv_image_header_cache_drop(&entry.image);
+        delete[] entry.data;
+        stats_.bytesUsed -= entry.bytes;
+        entry = Entry{};
+    }
+
+    /// Render text coverage into an A8 canvas, then build the RGB565A8 image from it
+    bool rasterize(Entry& entry, const char* text, const lv_font_t* font, lv_color_t color,
+                   lv_point_t size, uint32_t stride, size_t bytes) {
+        lv_draw_buf_t* coverage = lv_draw_buf_create(size.x, size.y, LV_COLOR_FORMAT_A8,
+                                                    LV_STRIDE_AUTO);
+        if (!coverage) return false;
+        lv_draw_buf_clear(coverage, nullptr);
+
+        lv_obj_t* canvas = lv_canvas_create(lv_layer_sys());
+        lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_canvas_set_draw_buf(canvas, coverage);
+
+        lv_layer_t layer;
+        lv_canvas_init_layer(canvas, &layer);
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        dsc.text = text;
+        dsc.font = font;
+        dsc.color = lv_color_white();
+        lv_area_t area = {0, 0, size.x - 1, size.y - 1};
+        lv_draw_label(&layer, &dsc, &area);
+        lv_canvas_finish_layer(canvas, &layer);
+        lv_obj_delete(canvas);
+
+        entry.data = new uint8_t[bytes];
+        entry.bytes = bytes;
+
+        // Color plane: solid text color; alpha plane (stride / 2): glyph coverage
+        const uint16_t color16 = lv_color_to_u16(color);
+        const uint32_t alphaStride = stride / 2;
+        auto* rgb = reinterpret_cast<uint16_t*>(entry.data);
+        for (size_t i = 0; i < size_t(alphaStride) * size.y; ++i) rgb[i] = color16;
+        uint8_t* alpha = entry.data + size_t(stride) * size.y;
+        for (int32_t y = 0; y < size.y; ++y) {
+            std::memcpy(alpha + y * alphaStride, coverage->data + y * coverage->header.stride,
+                        size.x);
+        }
+        lv_draw_buf_destroy(coverage);
+
+        lv_draw_buf_init(&entry.image, size.x, size.y, LV_COLOR_FORMAT_RGB565A8, stride,
+                         entry.data, bytes);
+        return true;
+    }
+
+    /// Time the text drawn as glyphs, then as the cached bitmap, into an RGB565 canvas
+    static uint32_t measureSaving(const lv_draw_buf_t& image, const char* text,
+                                  const lv_font_t* font, lv_color_t color, lv_point_t size) {
+        lv_draw_buf_t* target = lv_draw_buf_create(size.x, size.y, LV_COLOR_FORMAT_RGB565,
+                                                  LV_STRIDE_AUTO);
+        if (!target) return 0;
+        lv_draw_buf_clear(target, nullptr);
+
+        lv_obj_t* canvas = lv_canvas_create(lv_layer_sys());
+        lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_canvas_set_draw_buf(canvas, target);
+        const lv_area_t area = {0, 0, size.x - 1, size.y - 1};
+        lv_layer_t layer;
+
+        uint32_t start = micros();
+        lv_canvas_init_layer(canvas, &layer);
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        label.text = text;
+        label.font = font;
+        label.color = color;
+        lv_draw_label(&layer, &label, &area);
+        lv_canvas_finish_layer(canvas, &layer);
+        const uint32_t glyphUs = micros() - start;
+
+        start = micros();
+        lv_canvas_init_layer(canvas, &layer);
+        lv_draw_image_dsc_t blit;
+        lv_draw_image_dsc_init(&blit);
+        blit.src = &image;
+        lv_draw_image(&layer, &blit, &area);
+        lv_canvas_finish_layer(canvas, &layer);
+        const uint32_t blitUs = micros() - start;  // First blit: image cache lookup included
+
+        lv_obj_delete(canvas);
+        lv_draw_buf_destroy(target);
+        return glyphUs > blitUs ? glyphUs - blitUs : 0;
+    }
+
+    std::array<Entry, MAX_ENTRIES> entries_{};
+    size_t budget_;
+    uint32_t clock_ = 0;
+    uint32_t pendingDraws_ = 0;  ///< Draws of the frame being rendered
+    uint32_t pendingSavedUs_ = 0;
+    Stats stats_;
+};
+
+/**
+ * @brief Pinned cached label, shown as an lv_image (lv_label fallback)
+ *
+ * Owned by the widget displaying the text; releases the pin on destruction.
+ */
+class CachedLabel {
+public:
+    CachedLabel() = default;
+    ~CachedLabel() { reset(); }
+
+    CachedLabel(const CachedLabel&) = delete;
+    CachedLabel& operator=(const CachedLabel&) = delete;
+
+    /// Create the label object under parent
+    lv_obj_t* create(lv_obj_t* parent, const char* text, const lv_font_t* font,
+                     lv_color_t color) {
+        reset();
+        image_ = LabelCache::instance().acquire(text, font, color);
+        if (image_) {
+            auto* obj = lv_image_create(parent);
+            lv_image_set_src(obj, image_);
+            lv_obj_add_event_cb(obj, onDrawn, LV_EVENT_DRAW_MAIN_END, nullptr);
+            return obj;
+        }
+
+        auto* label = lv_label_create(parent);
+        lv_label_set_text(label, text);
+        lv_obj_set_style_text_font(label, font, 0);
+        lv_obj_set_style_text_color(label, color, 0);
+        return label;
+    }
+
+    /// Pin a bitmap for direct drawing (nullptr if it did not fit)
+    const lv_draw_buf_t* acquire(const char* text, const lv_font_t* font, lv_color_t color) {
+        reset();
+        image_ = LabelCache::instance().acquire(text, font, color);
+        return image_;
+    }
+
+    const lv_draw_buf_t* image() const { return image_; }
+
+    void reset() {
+        if (image_) {
+            LabelCache::instance().release(image_);
+            image_ = nullptr;
+        }
+    }
+
+private:
+    static void onDrawn(lv_event_t* e) {
+        auto* obj = static_cast<lv_obj_t*>(lv_event_get_target(e));
+        LabelCache::instance().drawn(static_cast<const lv_draw_buf_t*>(lv_image_get_src(obj)));
+    }
+
+    const lv_draw_buf_t* image_ = nullptr;
+};
+
+}  // namespace ui
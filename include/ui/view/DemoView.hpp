@@ -10,12 +10,37 @@
  * - Encoders in vertical flex column
  *
  * Widgets are auto-generated from Config arrays.
+ *
+ * Data binding (LV_USE_OBSERVER):
+ * - Handler writes model::PanelState at input rate (up to APP_HZ)
+ * - Each encoder/button has an lv_subject_t that its widget observes
+ * - sync() runs once per LVGL refresh (LV_EVENT_REFR_START, right before rendering)
+ *   and publishes only the controls whose dirty bit is set, with their latest value
+ * - After a frame over budget (ui::FrameBudget), deferrable encoder values (MIDI
+ *   feedback) are published only as far as the budget admits; the rest stay dirty
+ * - Encoder widgets glide to new values (ui::Smoother, one pass per refresh, no
+ *   lv_anim_t); bank switches, new widgets and frames over budget show them at once
+ *
+ * Encoder bank switch: the same widgets show the new bank's values and a bank label
+ * (bound to a subject) changes its text; nothing is re-created. The latency from the
+ * switch request to the end of the refresh drawing it (LV_EVENT_REFR_READY) is
+ * recorded in stats().
+ *
+ * The refresh callbacks are attached while the view is active only: a hidden view
+ * does no sync per refresh. Values written meanwhile stay dirty and are shown at once
+ * on the next activation.
  */
 
 #include "Config.hpp"
+#include "model/ControlState.hpp"
+#include "ui/FrameBudget.hpp"
+#include "ui/Smoother.hpp"
+#include "ui/cache/LabelCache.hpp"
 #include "ui/widget/ButtonIndicator.hpp"
+#include "ui/widget/EncoderBar.hpp"
 #include "ui/widget/EncoderSlider.hpp"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,20 +52,37 @@ namespace ui {
 /**
  * @brief Full-screen view with buttons and encoder sliders
  *
- * Auto-generates UI from Config::Button::BUTTONS and Config::Encoder::ENCODERS.
+ * Auto-generates UI from Config::Button (direct and scanned) and Config::Encoder::ENCODERS.
  *
  * Uses two-phase initialization for use as direct class member:
  * 1. Default construct
- * 2. Call onActivate() to create LVGL widgets
+ * 2. Call setState() with the model to display
+ * 3. Call onActivate() to create LVGL widgets
  */
 class DemoView : public oc::ui::lvgl::IView {
 public:
-    static constexpr size_t BUTTON_COUNT = Config::Button::BUTTONS.size();
+    static constexpr size_t BUTTON_COUNT = Config::Button::COUNT;
     static constexpr size_t ENCODER_COUNT = Config::Encoder::ENCODERS.size();
-    static constexpr float DEFAULT_VALUE = 0.5f;
 
-    /// Default constructor - call onActivate() to create widgets
-    DemoView() = default;
+    /// Encoder subjects hold the fixed-point position (0-POSITION_SCALE)
+    static constexpr int32_t POSITION_SCALE = model::POSITION_MAX;
+
+    /// Encoder widget: EncoderBar (1 object, single draw pass) or EncoderSlider (lv_slider)
+    using EncoderWidget = EncoderBar;
+
+    /// View sync counters (model writes/applied are in PanelState::stats())
+    struct Stats {
+        uint32_t syncs = 0;
+        uint32_t widgetUpdates = 0;
+        uint32_t lastSyncUs = 0;
+        uint32_t bankSwitches = 0;
+        uint32_t lastBankSwitchUs = 0;  ///< Request -> refresh drawing the new bank done
+        uint32_t maxBankSwitchUs = 0;
+    };
+
+    /// Call setState() then onActivate() to create widgets (one view per context)
+    explicit DemoView(const char* title = "Open Control", const char* viewId = "demo")
+        : title_(title), viewId_(viewId) {}
     ~DemoView() override { destroy(); }
 
     // ═══════════════════════════════════════════════════════════════════
@@ -56,40 +98,81 @@ public:
     void onActivate() override {
         if (!container_) {
             create();
+        } else {
+            snapEncoders_ = true;  // Skip the glide from values shown before deactivation
         }
         lv_obj_clear_flag(container_, LV_OBJ_FLAG_HIDDEN);
+        attachRefresh();
     }
 
     void onDeactivate() override {
         if (container_) {
+            detachRefresh();
             lv_obj_add_flag(container_, LV_OBJ_FLAG_HIDDEN);
         }
     }
 
-    const char* getViewId() const override { return "demo"; }
+    const char* getViewId() const override { return viewId_; }
 
     // ═══════════════════════════════════════════════════════════════════
-    // Public API (called by Handler)
+    // Public API
     // ═══════════════════════════════════════════════════════════════════
 
-    void setButton(size_t index, bool pressed) {
-        if (index < buttons_.size()) {
-            buttons_[index]->setPressed(pressed);
-        }
-    }
+    /// Model displayed by this view (written by Handler)
+    void setState(model::PanelState& state) { state_ = &state; }
 
-    void setEncoder(size_t index, float value) {
-        if (index < sliders_.size()) {
-            sliders_[index]->setValue(value);
-        }
-    }
+    /// Delete the LVGL widgets (ViewPool eviction); onActivate() re-creates them
+    void release() { destroy(); }
+
+    bool isCreated() const { return container_ != nullptr; }
 
-    void resetEncoderPositions() {
-        for (auto& slider : sliders_) {
-            slider->setValue(DEFAULT_VALUE);
+    /// Show the next synced encoder values at once, without glide (debug::FrameProbe)
+    void snapNext() { snapEncoders_ = true; }
+
+    /// Apply dirty model values to the widgets (once per refresh)
+    void sync() {
+        if (!state_ || (!state_->dirty() && !smoother_.active())) return;
+        const uint32_t start = micros();
+        FrameBudget& budget = FrameBudget::instance();
+
+        state_->consumeBank([this](size_t bank, bool switched, uint32_t switchUs) {
+            lv_subject_set_int(&bankSubject_, int32_t(bank) + 1);
+            if (switched) {
+                bankSwitchUs_ = switchUs;
+                bankSwitchPending_ = true;
+                snapEncoders_ = true;  // The new bank's values at once
+            }
+        });
+
+        // Over budget: values jump (one widget update each), no glide steps
+        const bool glide = !snapEncoders_ && !budget.degraded();
+        state_->consumeEncoders([&budget] { return budget.admit(); },
+                                [this, glide](size_t i, model::Position position) {
+                                    if (glide) {
+                                        smoother_.setTarget(i, position);
+                                        return;
+                                    }
+                                    smoother_.snap(i, position);
+                                    publishEncoder(i, position);
+                                });
+        snapEncoders_ = false;
+        if (smoother_.active() && budget.animate()) {
+            smoother_.step(micros(), [this](size_t i, int32_t value) { publishEncoder(i, value); });
         }
+
+        state_->consumeButtons([this, &budget](size_t i, bool pressed) {
+            ++stats_.widgetUpdates;
+            budget.spend();
+            lv_subject_set_int(&buttonSubjects_[i], pressed);
+        });
+
+        ++stats_.syncs;
+        stats_.lastSyncUs = micros() - start;
     }
 
+    const Stats& stats() const { return stats_; }
+    const Smoother<ENCODER_COUNT>::Stats& smoothing() const { return smoother_.stats(); }
+
 private:
     void create() {
         auto* screen = lv_screen_active();
@@ -103,7 +186,9 @@ private:
         lv_obj_set_flex_flow(container_, LV_FLEX_FLOW_COLUMN);
         lv_obj_set_style_pad_row(container_, 12, 0);
 
+        initSubjects();
         createTitle();
+        createBank();
         createButtons();
         createEncoders();
     }
@@ -112,16 +197,92 @@ private:
         buttons_.clear();
         sliders_.clear();
         if (container_) {
+            detachRefresh();
             lv_obj_delete(container_);
             container_ = nullptr;
+            deinitSubjects();
+        }
+        titleLabel_.reset();
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Refresh callbacks: sync() and bank switch latency, active view only
+    // ═══════════════════════════════════════════════════════════════════
+
+    void attachRefresh() {
+        if (refreshAttached_) return;
+        lv_display_t* display = lv_obj_get_display(container_);
+        lv_display_add_event_cb(display, onRefreshStart, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, onRefreshReady, LV_EVENT_REFR_READY, this);
+        refreshAttached_ = true;
+    }
+
+    void detachRefresh() {
+        if (!refreshAttached_) return;
+        lv_display_t* display = lv_obj_get_display(container_);
+        lv_display_remove_event_cb_with_user_data(display, onRefreshStart, this);
+        lv_display_remove_event_cb_with_user_data(display, onRefreshReady, this);
+        refreshAttached_ = false;
+        bankSwitchPending_ = false;  // Its refresh will not be seen
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Subjects: latest model values published once per refresh
+    // ═══════════════════════════════════════════════════════════════════
+
+    void initSubjects() {
+        for (auto& subject : encoderSubjects_) {
+            lv_subject_init_int(&subject, model::PanelState::DEFAULT_POSITION);
+        }
+        for (auto& subject : buttonSubjects_) lv_subject_init_int(&subject, 0);
+        lv_subject_init_int(&bankSubject_, 1);
+
+        // New widgets start from defaults: resend the whole model on the next sync, no glide
+        if (state_) state_->markAllDirty();
+        snapEncoders_ = true;
+    }
+
+    void deinitSubjects() {
+        for (auto& subject : encoderSubjects_) lv_subject_deinit(&subject);
+        for (auto& subject : buttonSubjects_) lv_subject_deinit(&subject);
+        lv_subject_deinit(&bankSubject_);
+        bankSwitchPending_ = false;
+    }
+
+    void publishEncoder(size_t i, int32_t position) {
+        ++stats_.widgetUpdates;
+        FrameBudget::instance().spend();
+        lv_subject_set_int(&encoderSubjects_[i], position);
+    }
+
+    static void onRefreshStart(lv_event_t* e) {
+        static_cast<DemoView*>(lv_event_get_user_data(e))->sync();
+    }
+
+    /// The refresh that synced a bank switch has drawn it: record the latency
+    static void onRefreshReady(lv_event_t* e) {
+        auto* self = static_cast<DemoView*>(lv_event_get_user_data(e));
+        if (!self->bankSwitchPending_) return;
+        self->bankSwitchPending_ = false;
+
+        Stats& stats = self->stats_;
+        ++stats.bankSwitches;
+        stats.lastBankSwitchUs = micros() - self->bankSwitchUs_;
+        if (stats.lastBankSwitchUs > stats.maxBankSwitchUs) {
+            stats.maxBankSwitchUs = stats.lastBankSwitchUs;
         }
     }
 
     void createTitle() {
+        titleLabel_.create(container_, title_, &lv_font_montserrat_16, lv_color_white());
+    }
+
+    /// Active encoder bank, text follows bankSubject_ (only with several banks)
+    void createBank() {
+        if (Config::Encoder::BANKS < 2) return;
         auto* label = lv_label_create(container_);
-        lv_label_set_text(label, "Open Control");
-        lv_obj_set_style_text_color(label, lv_color_white(), 0);
-        lv_obj_set_style_text_font(label, &lv_font_montserrat_16, 0);
+        lv_obj_set_style_text_color(label, lv_color_hex(0xAAAAAA), 0);
+        lv_label_bind_text(label, &bankSubject_, "BANK %d");
     }
 
     void createButtons() {
@@ -131,14 +292,16 @@ private:
         lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, 0);
         lv_obj_set_style_border_width(row, 0, 0);
         lv_obj_set_style_pad_all(row, 0, 0);
-        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW_WRAP);  // Mux panels: several rows
         lv_obj_set_style_pad_column(row, 8, 0);
+        lv_obj_set_style_pad_row(row, 4, 0);
 
         for (size_t i = 0; i < BUTTON_COUNT; ++i) {
             std::string name = "BTN " + std::to_string(i + 1);
             buttons_.push_back(
                 std::make_unique<ButtonIndicator>(row, name.c_str())
             );
+            buttons_.back()->bind(&buttonSubjects_[i]);
         }
     }
 
@@ -155,14 +318,29 @@ private:
         for (size_t i = 0; i < ENCODER_COUNT; ++i) {
             std::string name = "ENC " + std::to_string(i + 1);
             sliders_.push_back(
-                std::make_unique<EncoderSlider>(column, name.c_str())
+                std::make_unique<EncoderWidget>(column, name.c_str())
             );
+            sliders_.back()->bind(&encoderSubjects_[i], POSITION_SCALE);
         }
     }
 
+    const char* title_;
+    const char* viewId_;
     lv_obj_t* container_ = nullptr;
+    CachedLabel titleLabel_;
     std::vector<std::unique_ptr<ButtonIndicator>> buttons_;
-    std::vector<std::unique_ptr<EncoderSlider>> sliders_;
+    std::vector<std::unique_ptr<EncoderWidget>> sliders_;
+
+    std::array<lv_subject_t, ENCODER_COUNT> encoderSubjects_{};
+    std::array<lv_subject_t, BUTTON_COUNT> buttonSubjects_{};
+    lv_subject_t bankSubject_{};  ///< Active bank, 1-based
+    model::PanelState* state_ = nullptr;
+    Smoother<ENCODER_COUNT> smoother_;  ///< Displayed encoder positions
+    uint32_t bankSwitchUs_ = 0;
+    bool bankSwitchPending_ = false;
+    bool snapEncoders_ = false;     ///< Next sync shows encoder values without glide
+    bool refreshAttached_ = false;  ///< REFR_START / REFR_READY callbacks registered
+    Stats stats_;
 };
 
 }  // namespace ui
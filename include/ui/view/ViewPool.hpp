@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file ViewPool.hpp
+ * @brief Keeps inactive views' LVGL trees alive under a memory budget
+ *
+ * Switching contexts hides the outgoing view instead of deleting it, so coming
+ * back only clears LV_OBJ_FLAG_HIDDEN. Hidden views are accounted against
+ * Config::LVGL::VIEW_CACHE_BYTES; when the budget or the LVGL pool runs short,
+ * the least-recently-used hidden view releases its widgets (re-created lazily).
+ *
+ * Views must provide (see DemoView):
+ *   - void onActivate() / void onDeactivate()   (IView; a hidden view drops its
+ *     per-refresh work in onDeactivate())
+ *   - void release()         destroy LVGL widgets, keep the C++ object
+ *   - bool isCreated() const
+ */
+
+#include <Arduino.h>
+
+#include "Config.hpp"
+
+#include <array>
+
+#include <lvgl.h>
+
+namespace ui {
+
+class ViewPool {
+public:
+    static constexpr size_t MAX_VIEWS = size_t(Config::ContextID::_COUNT);
+
+    struct Stats {
+        uint32_t switches = 0;
+        uint32_t cacheHits = 0;   ///< Activated with widgets still alive
+        uint32_t creations = 0;   ///< Widgets (re)built
+        uint32_t evictions = 0;
+        uint32_t lastActivateUs = 0;
+        size_t cachedBytes = 0;   ///< LVGL memory held by hidden views
+    };
+
+    static ViewPool& instance() {
+        static ViewPool pool;
+        return pool;
+    }
+
+    /// Show a view, evicting hidden views first if memory is short
+    template <typename View>
+    void activate(View& view) {
+        const uint32_t start = micros();
+        Entry& entry = entryFor(view);
+        ++stats_.switches;
+
+        if (view.isCreated()) {
+            ++stats_.cacheHits;
+            if (!entry.active) stats_.cachedBytes -= entry.bytes;
+            view.onActivate();
+        } else {
+            makeRoom(entry.bytes);
+            const size_t before = lvglUsed();
+            view.onActivate();
+            const size_t after = lvglUsed();
+            entry.bytes = after > before ? after - before : 0;
+            ++stats_.creations;
+        }
+
+        entry.active = true;
+        entry.lastUse = ++clock_;
+        stats_.lastActivateUs = micros() - start;
+    }
+
+    /// Hide a view, keeping its widgets while the budget allows
+    template <typename View>
+    void deactivate(View& view) {
+        Entry& entry = entryFor(view);
+        view.onDeactivate();
+        if (!entry.active) return;
+        entry.active = false;
+        if (view.isCreated()) stats_.cachedBytes += entry.bytes;
+        makeRoom(0);
+    }
+
+    /// Forget a view about to be destroyed (its owner is going away)
+    template <typename View>
+    void remove(View& view) {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].view != &view) continue;
+            if (!entries_[i].active && view.isCreated()) stats_.cachedBytes -= entries_[i].bytes;
+            entries_[i] = entries_[--count_];
+            entries_[count_] = Entry{};
+            return;
+        }
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        void* view = nullptr;
+        void (*release)(void*) = nullptr;
+        bool (*isCreated)(const void*) = nullptr;
+        size_t bytes = 0;  ///< LVGL memory of its widget tree (measured at creation)
+        uint32_t lastUse = 0;
+        bool active = false;
+    };
+
+    ViewPool() = default;
+
+    template <typename View>
+    Entry& entryFor(View& view) {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].view == &view) return entries_[i];
+        }
+        // One view per context: MAX_VIEWS slots always suffice
+        Entry& entry = entries_[count_ < MAX_VIEWS ? count_++ : MAX_VIEWS - 1];
+        entry = Entry{};
+        entry.view = &view;
+        entry.release = [](void* v) { static_cast<View*>(v)->release(); };
+        entry.isCreated = [](const void* v) {
+            return static_cast<const View*>(v)->isCreated();
+        };
+        return entry;
+    }
+
+    /// Evict hidden views (LRU first) until they fit the budget and `incoming` bytes fit
+    /// in the LVGL pool on top of the reserve
+    void makeRoom(size_t incoming) {
+        while (stats_.cachedBytes > Config::LVGL::VIEW_CACHE_BYTES ||
+               lvglFree() < Config::LVGL::VIEW_RESERVE_BYTES + incoming) {
+            Entry* victim = nullptr;
+            for (size_t i = 0; i < count_; ++i) {
+                Entry& e = entries_[i];
+                if (e.active || !e.isCreated(e.view)) continue;
+                if (!victim || e.lastUse < victim->lastUse) victim = &e;
+            }
+            if (!victim) return;
+
+            victim->release(victim->view);
+            stats_.cachedBytes -= victim->bytes;
+            ++stats_.evictions;
+        }
+    }
+
+    static size_t lvglUsed() {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.total_size - mon.free_size;
+    }
+
+    static size_t lvglFree() {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.free_size;
+    }
+
+    std::array<Entry, MAX_VIEWS> entries_{};
+    size_t count_ = 0;
+    uint32_t clock_ = 0;
+    Stats stats_;
+};
+
+}  // namespace ui
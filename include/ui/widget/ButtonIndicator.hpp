@@ -8,6 +8,8 @@
  * Auto-generated from Config::Button::BUTTONS array.
  */
 
+#include "ui/cache/LabelCache.hpp"
+
 #include <oc/ui/lvgl/IWidget.hpp>
 
 namespace ui {
@@ -44,10 +46,10 @@ public:
         lv_obj_set_style_radius(container_, style_.radius, 0);
         lv_obj_set_style_border_width(container_, 0, 0);
 
-        // Centered label
-        label_ = lv_label_create(container_);
-        lv_label_set_text(label_, label);
-        lv_obj_set_style_text_color(label_, lv_color_white(), 0);
+        // Centered label (pre-rasterized, static text)
+        label_ = cachedLabel_.create(container_, label,
+                                     lv_obj_get_style_text_font(container_, LV_PART_MAIN),
+                                     lv_color_white());
         lv_obj_center(label_);
     }
 
@@ -67,10 +69,21 @@ public:
         lv_obj_set_style_bg_color(container_, lv_color_hex(color), 0);
     }
 
+    /// Follow an int subject (0 = released), observer removed with the object
+    void bind(lv_subject_t* subject) {
+        lv_subject_add_observer_obj(subject, onSubject, container_, this);
+    }
+
 private:
+    static void onSubject(lv_observer_t* observer, lv_subject_t* subject) {
+        auto* self = static_cast<ButtonIndicator*>(lv_observer_get_user_data(observer));
+        self->setPressed(lv_subject_get_int(subject) != 0);
+    }
+
     Style style_;
     lv_obj_t* container_ = nullptr;
     lv_obj_t* label_ = nullptr;
+    CachedLabel cachedLabel_;
 };
 
 }  // namespace ui
@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file EncoderBar.hpp
+ * @brief Lightweight encoder bar drawn in a single draw pass
+ *
+ * Drop-in replacement for EncoderSlider built on one plain lv_obj:
+ *   - EncoderSlider: lv_slider (MAIN + INDICATOR + KNOB) + lv_label = 2 objects, 4 parts
+ *   - EncoderBar:    lv_obj + custom DRAW_MAIN callback              = 1 object,  1 part
+ *
+ * Value changes invalidate only the columns between the old and new fill edge.
+ * Auto-generated from Config::Encoder::ENCODERS array.
+ */
+
+#include "ui/cache/LabelCache.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <oc/ui/lvgl/IWidget.hpp>
+
+namespace ui {
+
+/// Visual style for EncoderBar
+struct EncoderBarStyle {
+    uint32_t bgColor = 0x333355;
+    uint32_t fillColor = 0x6666ff;
+    uint32_t labelColor = 0xAAAAAA;
+    int32_t height = 32;
+    int32_t radius = 4;
+};
+
+/**
+ * @brief Encoder value bar with embedded label
+ *
+ * Bar fills from left based on normalized value (0.0-1.0).
+ * Background, fill and label are drawn by one callback; the label is
+ * pre-rasterized once (LabelCache) and only blitted at draw time.
+ */
+class EncoderBar : public oc::ui::lvgl::IWidget {
+public:
+    using Style = EncoderBarStyle;
+
+    EncoderBar(lv_obj_t* parent, const char* name) : EncoderBar(parent, name, Style{}) {}
+
+    EncoderBar(lv_obj_t* parent, const char* name, const Style& style)
+        : style_(style), name_(name)
+    {
+        obj_ = lv_obj_create(parent);
+        lv_obj_remove_style_all(obj_);
+        lv_obj_set_size(obj_, LV_PCT(100), style_.height);
+        lv_obj_clear_flag(obj_, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_clear_flag(obj_, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(obj_, onDraw, LV_EVENT_DRAW_MAIN, this);
+
+        // Text never changes: measure once, rasterize once if the cache has room
+        font_ = lv_obj_get_style_text_font(obj_, LV_PART_MAIN);
+        lv_text_get_size(&labelSize_, name_.c_str(), font_, 0, 0, LV_COORD_MAX,
+                         LV_TEXT_FLAG_NONE);
+        cachedLabel_.acquire(name_.c_str(), font_, lv_color_hex(style_.labelColor));
+    }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // IWidget interface
+    // ═══════════════════════════════════════════════════════════════════
+
+    lv_obj_t* getElement() const override { return obj_; }
+
+    // ═══════════════════════════════════════════════════════════════════
+    // Public API
+    // ═══════════════════════════════════════════════════════════════════
+
+    /// Fixed-point value resolution (setPosition range)
+    static constexpr int32_t RESOLUTION = 0xFFFF;
+
+    /// Set bar value (0.0-1.0 normalized)
+    void setValue(float normalized) {
+        setPosition(int32_t(std::clamp(normalized, 0.0f, 1.0f) * RESOLUTION + 0.5f));
+    }
+
+    /// Set bar value (0-RESOLUTION), integer only
+    void setPosition(int32_t position) {
+        position = std::clamp(position, int32_t(0), RESOLUTION);
+        if (position == position_) return;
+        if (!drawn_) {  // Coords not laid out yet; the first draw covers the whole bar
+            position_ = position;
+            return;
+        }
+
+        lv_area_t coords;
+        lv_obj_get_coords(obj_, &coords);
+        const int32_t oldEdge = fillEdge(coords);
+        position_ = position;
+        const int32_t newEdge = fillEdge(coords);
+        if (oldEdge == newEdge) return;
+
+        // Only the strip between both edges changes (+ radius for the rounded fill end)
+        lv_area_t strip = coords;
+        strip.x1 = std::max(coords.x1, std::min(oldEdge, newEdge) - style_.radius);
+        strip.x2 = std::min(coords.x2, std::max(oldEdge, newEdge) + style_.radius);
+        lv_obj_invalidate_area(obj_, &strip);
+    }
+
+    /// Get current value (0.0-1.0 normalized)
+    float getValue() const { return float(position_) / RESOLUTION; }
+
+    /// Follow an int subject holding value * fullScale (observer removed with the object)
+    void bind(lv_subject_t* subject, int32_t fullScale) {
+        fullScale_ = fullScale;
+        lv_subject_add_observer_obj(subject, onSubject, obj_, this);
+    }
+
+private:
+    static void onSubject(lv_observer_t* observer, lv_subject_t* subject) {
+        auto* self = static_cast<EncoderBar*>(lv_observer_get_user_data(observer));
+        const int32_t value = lv_subject_get_int(subject);
+        self->setPosition(self->fullScale_ == RESOLUTION
+                              ? value
+                              : int32_t(int64_t(value) * RESOLUTION / self->fullScale_));
+    }
+
+    /// First column past the fill (fill covers [x1, edge))
+    int32_t fillEdge(const lv_area_t& coords) const {
+        if (position_ <= 0) return coords.x1;
+        return coords.x1 + (position_ * lv_area_get_width(&coords) + RESOLUTION / 2) / RESOLUTION;
+    }
+
+    static void onDraw(lv_event_t* e) {
+        auto* self = static_cast<EncoderBar*>(lv_event_get_user_data(e));
+        self->draw(lv_event_get_layer(e));
+    }
+
+    void draw(lv_layer_t* layer) {
+        drawn_ = true;
+        lv_area_t coords;
+        lv_obj_get_coords(obj_, &coords);
+
+        lv_draw_rect_dsc_t rect;
+        lv_draw_rect_dsc_init(&rect);
+        rect.radius = style_.radius;
+        rect.bg_color = lv_color_hex(style_.bgColor);
+        lv_draw_rect(layer, &rect, &coords);
+
+        const int32_t edge = fillEdge(coords);
+        if (edge > coords.x1) {
+            lv_area_t fill = coords;
+            fill.x2 = edge - 1;
+            rect.bg_color = lv_color_hex(style_.fillColor);
+            lv_draw_rect(layer, &rect, &fill);
+        }
+
+        lv_area_t text;
+        text.x1 = coords.x1 + (lv_area_get_width(&coords) - labelSize_.x) / 2;
+        text.y1 = coords.y1 + (lv_area_get_height(&coords) - labelSize_.y) / 2;
+        text.x2 = text.x1 + labelSize_.x - 1;
+        text.y2 = text.y1 + labelSize_.y - 1;
+
+        if (const lv_draw_buf_t* image = cachedLabel_.image()) {
+            lv_draw_image_dsc_t blit;
+            lv_draw_image_dsc_init(&blit);
+            blit.src = image;
+            lv_draw_image(layer, &blit, &text);
+            LabelCache::instance().drawn(image);
+            return;
+        }
+
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        label.text = name_.c_str();
+        label.font = font_;
+        label.color = lv_color_hex(style_.labelColor);
+        lv_draw_label(layer, &label, &text);
+    }
+
+    Style style_;
+    std::string name_;
+    lv_obj_t* obj_ = nullptr;
+    const lv_font_t* font_ = nullptr;
+    lv_point_t labelSize_{};
+    CachedLabel cachedLabel_;
+    int32_t fullScale_ = 1;
+    int32_t position_ = RESOLUTION / 2;  ///< Initial value: shown by the first draw
+    bool drawn_ = false;  ///< Laid out and drawn once: invalidate deltas from now on
+};
+
+}  // namespace ui
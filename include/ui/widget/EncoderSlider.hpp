@@ -6,8 +6,17 @@
  *
  * Horizontal slider with label overlay in the background.
  * Auto-generated from Config::Encoder::ENCODERS array.
+ *
+ * Value changes invalidate only the columns between the old and new
+ * indicator edge instead of the whole slider (full width x height).
+ *
+ * Not used in the default build: DemoView uses EncoderBar, which invalidates its
+ * fill delta the same way. Kept as the lv_slider baseline of debug/WidgetBench.hpp.
  */
 
+#include "ui/cache/LabelCache.hpp"
+
+#include <algorithm>
 
 #include <oc/ui/lvgl/IWidget.hpp>
 
@@ -51,13 +60,13 @@ public:
         lv_obj_set_style_bg_opa(slider_, LV_OPA_TRANSP, LV_PART_KNOB);
         lv_obj_set_style_pad_all(slider_, 0, LV_PART_KNOB);
 
-        // Label overlay (centered in slider)
-        label_ = lv_label_create(slider_);
-        lv_label_set_text(label_, name);
-        lv_obj_set_style_text_color(label_, lv_color_hex(style_.labelColor), 0);
+        // Label overlay (centered in slider, pre-rasterized)
+        label_ = cachedLabel_.create(slider_, name,
+                                     lv_obj_get_style_text_font(slider_, LV_PART_MAIN),
+                                     lv_color_hex(style_.labelColor));
         lv_obj_center(label_);
 
-        setValue(0.5f);
+        lv_slider_set_value(slider_, 50, LV_ANIM_OFF);  // New object: fully drawn anyway
     }
 
     // ═══════════════════════════════════════════════════════════════════
@@ -71,19 +80,65 @@ public:
     // ═══════════════════════════════════════════════════════════════════
 
     /// Set slider value (0.0-1.0 normalized)
-    void setValue(float normalized) {
-        lv_slider_set_value(slider_, int32_t(normalized * 100), LV_ANIM_ON);
-    }
+    void setValue(float normalized) { setSliderValue(int32_t(normalized * 100)); }
 
     /// Get current value (0.0-1.0 normalized)
     float getValue() const {
         return lv_slider_get_value(slider_) / 100.0f;
     }
 
+    /// Follow an int subject holding value * fullScale (observer removed with the object)
+    void bind(lv_subject_t* subject, int32_t fullScale) {
+        fullScale_ = fullScale;
+        lv_subject_add_observer_obj(subject, onSubject, slider_, this);
+    }
+
 private:
+    static void onSubject(lv_observer_t* observer, lv_subject_t* subject) {
+        auto* self = static_cast<EncoderSlider*>(lv_observer_get_user_data(observer));
+        const int64_t value = lv_subject_get_int(subject);
+        self->setSliderValue(int32_t(value * 100 / self->fullScale_));
+    }
+
+    /// Slider value (0-100), integer only
+    void setSliderValue(int32_t value) {
+        const int32_t previous = lv_slider_get_value(slider_);
+        if (value == previous) return;
+
+        // lv_slider invalidates the whole object: mute it, then invalidate the delta only
+        lv_display_t* display = lv_obj_get_display(slider_);
+        lv_display_enable_invalidation(display, false);
+        lv_slider_set_value(slider_, value, LV_ANIM_OFF);
+        lv_display_enable_invalidation(display, true);
+
+        invalidateDelta(previous, lv_slider_get_value(slider_));
+    }
+
+    /// Invalidate the strip between two indicator edges (label child is redrawn within it)
+    void invalidateDelta(int32_t from, int32_t to) {
+        lv_obj_update_layout(slider_);  // Coords of a new slider are not laid out yet
+        lv_area_t coords;
+        lv_obj_get_coords(slider_, &coords);
+        coords.x1 += lv_obj_get_style_pad_left(slider_, LV_PART_MAIN);
+        coords.x2 -= lv_obj_get_style_pad_right(slider_, LV_PART_MAIN);
+
+        const int32_t width = lv_area_get_width(&coords);
+        const int32_t x1 = coords.x1 + width * std::min(from, to) / 100;
+        const int32_t x2 = coords.x1 + width * std::max(from, to) / 100;
+
+        // Widen by the corner radius (rounded indicator end) and 1 px of rounding slack
+        lv_area_t strip;
+        lv_obj_get_coords(slider_, &strip);
+        strip.x1 = std::max(strip.x1, x1 - style_.radius - 1);
+        strip.x2 = std::min(strip.x2, x2 + style_.radius + 1);
+        lv_obj_invalidate_area(slider_, &strip);
+    }
+
     Style style_;
     lv_obj_t* slider_ = nullptr;
     lv_obj_t* label_ = nullptr;
+    CachedLabel cachedLabel_;
+    int32_t fullScale_ = 1;
 };
 
 }  // namespace ui
@@ -12,22 +12,50 @@
  * - Display and LVGL are initialized first (static lifetime)
  * - OpenControlApp manages hardware polling and context lifecycle
  * - StandaloneContext creates the UI and binds inputs to MIDI
+ * - DawContext is a second context; a long press on button 1 switches contexts
  *
- * The main loop runs at APP_HZ for responsive encoder tracking,
- * while LVGL refreshes at the lower LVGL_HZ to save CPU cycles.
+ * The main loop runs at APP_HZ for responsive encoder tracking, while LVGL
+ * frames are paced on the panel's measured refresh (ui::FramePacer, ~LVGL_HZ).
+ * Between ticks the core sleeps until an interrupt (power::TickClock), and
+ * the core clock is lowered while the panel is idle (power::Governor).
  *
  * NOTE: Enable -D OC_LOG in platformio.ini build_flags to see debug output.
  *       Remove it for production (zero overhead, instant boot).
  *
+ * NOTE: Add -D OC_FRAME_PROBE to play the input script of debug/FrameGolden.hpp into
+ *       DemoView at boot and check each frame's CRC and render time (halts on failure).
+ *
+ * NOTE: Add -D OC_WIDGET_BENCH to log objects, invalidated pixels and render time
+ *       per frame of EncoderBar vs EncoderSlider at boot (debug/WidgetBench.hpp).
+ *
  * Hardware configuration is in Config.hpp - ADAPT pins to your wiring.
  */
 
 #include "Buffer.hpp"
 #include "Config.hpp"
+#include "ConfigCheck.hpp"
+#include "context/ContextSwitch.hpp"
+#include "context/DawContext.hpp"
 #include "context/StandaloneContext.hpp"
+#include "input/MatrixScanner.hpp"
+#include "input/MuxScanner.hpp"
+#include "input/QuadDecoder.hpp"
+#include "power/Governor.hpp"
+#include "power/TickClock.hpp"
+#include "ui/FrameBudget.hpp"
+#include "ui/FramePacer.hpp"
+#include "ui/cache/LabelCache.hpp"
 
 #include <optional>
 
+#ifdef OC_FRAME_PROBE
+#include "debug/FrameProbe.hpp"
+#endif
+
+#ifdef OC_WIDGET_BENCH
+#include "debug/WidgetBench.hpp"
+#endif
+
 #include <oc/teensy/Teensy.hpp>
 #include <oc/app/OpenControlApp.hpp>
 #include <oc/core/Result.hpp>
@@ -66,17 +94,93 @@ static void initDisplay() {
 static void initLVGL() {
     lvgl = oc::ui::lvgl::Bridge(*display, Buffer::lvgl, oc::teensy::defaultTimeProvider, Config::LVGL::CONFIG);
     checkOrHalt(lvgl->init(), "LVGL");
+
+    // Glyph render time saved by pre-rasterized labels, counted per frame
+    ui::LabelCache::instance().begin(lv_display_get_default());
+}
+
+#ifdef OC_FRAME_PROBE
+// Render regression check, before the contexts create their views: halts on failure
+static void probeFrames() {
+    const auto result = debug::runFrameProbe(
+        lv_display_get_default(), [](const debug::ProbeFrame& frame, const lv_draw_buf_t& buffer) {
+            if (frame.pass == 0) {
+                OC_LOG_INFO("Frame probe step {}: crc {}, render {} us", frame.step, frame.crc,
+                            frame.renderUs);
+            }
+            if (frame.crcMismatch) {
+                OC_LOG_ERROR("Frame probe step {}: CRC differs from golden {}", frame.step,
+                             debug::FRAME_GOLDEN[frame.step].crc);
+            }
+            if (frame.slow) {
+                OC_LOG_ERROR("Frame probe step {}: {} us, baseline {} us + {}%", frame.step,
+                             frame.renderUs, debug::FRAME_GOLDEN[frame.step].renderUs,
+                             debug::RENDER_TOLERANCE_PCT);
+            }
+            if (frame.unstable) {
+                OC_LOG_ERROR("Frame probe step {}: second pass rendered crc {}", frame.step,
+                             frame.crc);
+            }
+            if (frame.crcMismatch || frame.unstable) debug::dumpPpm(buffer);
+        });
+
+    OC_LOG_INFO("Frame probe: {} frames, {} CRC mismatches, {} slow, {} unstable{}",
+                result.frames, result.crcMismatches, result.slowFrames, result.unstableFrames,
+                result.recording ? " (no golden frames: recorded only)" : "");
+    if (!result.passed()) {
+        OC_LOG_ERROR("Frame probe failed");
+        while (true) {}
+    }
+}
+#endif
+
+#ifdef OC_WIDGET_BENCH
+// Encoder widgets compared on the target, before the contexts create their views
+static void benchWidgets() {
+    lv_display_t* disp = lv_display_get_default();
+    const auto bar = debug::benchWidget<ui::EncoderBar>(disp);
+    const auto slider = debug::benchWidget<ui::EncoderSlider>(disp);
+    OC_LOG_INFO("EncoderBar:    {} objects, {} px invalidated, {} us/frame (max {})",
+                bar.objects, bar.invalidatedPx, bar.meanRenderUs, bar.maxRenderUs);
+    OC_LOG_INFO("EncoderSlider: {} objects, {} px invalidated, {} us/frame (max {})",
+                slider.objects, slider.invalidatedPx, slider.meanRenderUs, slider.maxRenderUs);
 }
+#endif
 
 static void initApp() {
     app = oc::teensy::AppBuilder()
         .midi()
-        .encoders(Config::Encoder::ENCODERS)
+        .encoders(Config::Encoder::INTERRUPT_ENCODERS)  // QUAD_DECODER ones: input::QuadDecoder
         .buttons(Config::Button::BUTTONS, Config::Timing::DEBOUNCE_MS)
         .inputConfig(Config::Input::CONFIG);
 
     app->registerContext<context::StandaloneContext>(Config::ContextID::STANDALONE, "Standalone");
+    app->registerContext<context::DawContext>(Config::ContextID::DAW, "DAW");
     app->begin();
+
+    // Mux/matrix buttons: sampled by timers, polled by the active context's handler
+    input::MuxScanner::instance().begin();
+    input::MatrixScanner::instance().begin();
+
+    // QUAD_DECODER encoders: counted by the ENC peripherals, read by the handler
+    input::QuadDecoder::instance().begin();
+}
+
+// Log each switch to IDLE_HZ: the panel went idle and nothing (frame probes included)
+// kept the core at full speed. Also logs the load of the last second (idle share,
+// WFI wakeups) and the wake latencies so far, so the power figures come from the target
+static void logThrottle() {
+    static uint32_t throttles = 0;
+    const power::Governor::Stats& governor = power::Governor::instance().stats();
+    if (governor.throttles == throttles) return;
+    throttles = governor.throttles;
+    const power::TickClock::Load& load = power::TickClock::instance().load();
+    OC_LOG_INFO("Core idle at {} MHz (throttle #{})", Config::Power::IDLE_HZ / 1'000'000,
+                throttles);
+    OC_LOG_INFO("Last second: idle {} permille, {} wakeups/s, longest tick {} us",
+                load.idlePermille, load.wakeupsPerSec, load.busyUsMax);
+    OC_LOG_INFO("Wakes: {}, clock switch max {} us, wake to first frame max {} us",
+                governor.wakes, governor.maxSwitchUs, governor.maxFirstFrameUs);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -88,30 +192,55 @@ void setup() {
 
     initDisplay();
     initLVGL();
+#ifdef OC_FRAME_PROBE
+    probeFrames();
+#endif
+#ifdef OC_WIDGET_BENCH
+    benchWidgets();
+#endif
     initApp();
+    power::TickClock::instance().begin();
+    power::Governor::instance().begin(lv_display_get_default());
+
+    // Panel refresh measured with the first screen, frames paced on it from now on
+    auto& pacer = ui::FramePacer::instance();
+    pacer.begin(lv_display_get_default());
+    pacer.calibrate();
+    OC_LOG_INFO("Frame period {} us{}", pacer.stats().periodUs,
+                pacer.stats().calibrated ? "" : " (nominal, no vsync)");
+
+    // The calibration frames drew the first screen in full
+    const auto& labels = ui::LabelCache::instance().stats();
+    OC_LOG_INFO("Label cache: {} us glyph render saved per full frame ({} labels last frame)",
+                labels.maxFrameSavedUs, labels.frameDraws);
+
+    // Render time of each frame against Config::LVGL::RENDER_BUDGET_US
+    ui::FrameBudget::instance().begin(lv_display_get_default());
 
     OC_LOG_INFO("Ready");
 }
 
-// Timing constants for main loop
-constexpr uint32_t APP_PERIOD_US = 1'000'000 / Config::Timing::APP_HZ;
-constexpr uint32_t LVGL_PERIOD_US = 1'000'000 / Config::Timing::LVGL_HZ;
-
 void loop() {
-    static uint32_t lastMicros = 0;
-    static uint32_t lvglAccumulator = 0;
-
-    const uint32_t now = micros();
-    if (now - lastMicros < APP_PERIOD_US) return;
-    lastMicros = now;
+    // Sleep until the next app tick (late ticks are merged, not replayed)
+    power::TickClock::instance().wait();
 
     // Poll hardware and update active context
     app->update();
+    power::Governor::instance().update();
+    logThrottle();
+
+    // Context switches requested by input callbacks, applied outside of them
+    auto switchTo = [](Config::ContextID id) { return bool(app->switchToContext(id)); };
+    if (context::Switch::apply(switchTo)) {
+        OC_LOG_INFO("Context {} active in {} us", uint8_t(context::Switch::active),
+                    context::Switch::stats.lastUs);
+    }
 
-    // Refresh LVGL at lower frequency to reduce CPU load
-    lvglAccumulator += APP_PERIOD_US;
-    if (lvglAccumulator >= LVGL_PERIOD_US) {
-        lvglAccumulator = 0;
-        lvgl->refresh();
+    // Render once per panel refresh, timed to be flushed just before the vsync
+    auto& pacer = ui::FramePacer::instance();
+    if (pacer.due(micros())) {
+        usbMIDI.send_now();  // This tick's MIDI leaves before the frame blocks the loop
+        pacer.render([] { lvgl->refresh(); });
+        power::Governor::instance().frameDone();
     }
 }
@@ -0,0 +1,181 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of the MIDI clock follower (midi/ClockSync.hpp)
+ *
+ * Synthetic F8 ticks with the Config::Midi clock settings:
+ *   - lock: exact ticks give the tempo and beat position at once
+ *   - jitter: timestamps quantized to the 100 us capture period plus up to 1 ms of
+ *     USB frame delay; the filtered tempo and beat phase stay far tighter than that
+ *   - tempo change: a small step is tracked by the DLL, a large one relocks it
+ *   - timeout and transport (Start / Stop / Continue)
+ *
+ * Run with: pio test -e native -f test_clocksync
+ */
+
+#include <unity.h>
+
+#include "midi/ClockSync.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+using midi::ClockSync;
+
+namespace {
+
+constexpr midi::ClockSettings SETTINGS = {0.02, 0.5, 250'000};  // Config::Midi values
+
+constexpr uint8_t CLOCK = 0xF8;
+constexpr uint8_t START = 0xFA;
+constexpr uint8_t CONTINUE = 0xFB;
+constexpr uint8_t STOP = 0xFC;
+
+double tickUs(double bpm) { return 60e6 / (bpm * ClockSync::TICKS_PER_BEAT); }
+
+/// Clock source: ideal tick times, received with an optional delay
+class Source {
+public:
+    Source(ClockSync& clock, uint32_t seed = 1) : clock_(clock), rng_(seed) {}
+
+    /// `count` ticks at `bpm`; each received up to `jitterUs` late, on a `quantumUs` grid
+    void play(double bpm, uint32_t count, double jitterUs = 0.0, uint32_t quantumUs = 1) {
+        std::uniform_real_distribution<double> delay(0.0, jitterUs);
+        for (uint32_t i = 0; i < count; ++i) {
+            timeUs_ += tickUs(bpm);
+            const double received = timeUs_ + (jitterUs > 0.0 ? delay(rng_) : 0.0);
+            const uint32_t stamp = uint32_t(received) / quantumUs * quantumUs;
+            clock_.onRealtime(CLOCK, stamp);
+        }
+    }
+
+    void send(uint8_t status) { clock_.onRealtime(status, uint32_t(timeUs_)); }
+    double now() const { return timeUs_; }
+
+private:
+    ClockSync& clock_;
+    std::mt19937 rng_;
+    double timeUs_ = 1'000'000.0;
+};
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_lock() {
+    ClockSync clock(SETTINGS);
+    Source source(clock);
+    TEST_ASSERT_FALSE(clock.locked(0));
+    source.send(START);
+    source.play(120.0, 2);
+    const uint32_t now = uint32_t(source.now());
+    TEST_ASSERT_TRUE(clock.locked(now));
+    TEST_ASSERT_TRUE(clock.running(now));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 120.0, clock.bpm());
+
+    source.play(120.0, 46);  // 48 ticks: two beats
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 120.0, clock.bpm());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 47.0 / 24.0, clock.beats(uint32_t(source.now())));
+    // Half a tick later: interpolated
+    TEST_ASSERT_FLOAT_WITHIN(0.002, 47.5 / 24.0,
+                             clock.beats(uint32_t(source.now() + tickUs(120.0) / 2)));
+    TEST_ASSERT_EQUAL(0, clock.stats().relocks);
+}
+
+void test_jitter_rejection() {
+    // 1 ms of USB delay on a 20.8 ms tick, 100 us timestamps: +/-5 % raw interval error
+    ClockSync clock(SETTINGS);
+    Source source(clock, 37);
+    source.send(START);
+    source.play(120.0, 96, 1000.0, 100);
+
+    double worstBpm = 0.0;
+    double worstPhaseUs = 0.0;
+    for (int i = 0; i < 960; ++i) {
+        source.play(120.0, 1, 1000.0, 100);
+        worstBpm = std::fmax(worstBpm, std::fabs(clock.bpm() - 120.0));
+        // Beat position half a tick after the ideal tick, against the ideal position
+        const double ideal = double(96 + i) / 24.0 + 0.5 / 24.0;
+        const double at = clock.beats(uint32_t(source.now() + tickUs(120.0) / 2));
+        worstPhaseUs = std::fmax(worstPhaseUs, std::fabs(at - ideal) * 24.0 * tickUs(120.0));
+    }
+    TEST_ASSERT_EQUAL(0, clock.stats().relocks);
+    TEST_ASSERT_TRUE(worstBpm < 0.5);        // Raw intervals: +/-6 BPM
+    TEST_ASSERT_TRUE(worstPhaseUs < 1000.0);  // Within the USB delay
+    TEST_ASSERT_TRUE(clock.stats().jitterUs > 100.0);  // The input did jitter
+}
+
+void test_tempo_change_tracked() {
+    // +5 %: below the relock threshold, followed by the loop
+    ClockSync clock(SETTINGS);
+    Source source(clock);
+    source.send(START);
+    source.play(120.0, 96);
+    uint32_t settled = 0;
+    for (uint32_t i = 1; i <= 240 && !settled; ++i) {
+        source.play(126.0, 1);
+        if (std::fabs(clock.bpm() - 126.0) < 0.1) settled = i;
+    }
+    TEST_ASSERT_EQUAL(0, clock.stats().relocks);
+    TEST_ASSERT_TRUE(settled > 0);
+    TEST_ASSERT_TRUE(settled <= 48);  // Within two beats
+    source.play(126.0, 96);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 126.0, clock.bpm());
+}
+
+void test_tempo_jump_relocks() {
+    ClockSync clock(SETTINGS);
+    Source source(clock);
+    source.send(START);
+    source.play(120.0, 48);
+    source.play(60.0, 1);  // Tick twice as late: relock on the new interval
+    TEST_ASSERT_EQUAL(1, clock.stats().relocks);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 60.0, clock.bpm());
+    source.play(60.0, 24);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 60.0, clock.bpm());
+    TEST_ASSERT_EQUAL(1, clock.stats().relocks);
+}
+
+void test_timeout() {
+    ClockSync clock(SETTINGS);
+    Source source(clock);
+    source.send(START);
+    source.play(120.0, 24);
+    const uint32_t last = uint32_t(source.now());
+    TEST_ASSERT_TRUE(clock.locked(last + SETTINGS.timeoutUs - 1));
+    TEST_ASSERT_FALSE(clock.locked(last + SETTINGS.timeoutUs));
+    TEST_ASSERT_FALSE(clock.running(last + SETTINGS.timeoutUs));
+}
+
+void test_transport() {
+    ClockSync clock(SETTINGS);
+    Source source(clock);
+    source.play(120.0, 24);  // Clock without Start: locked, not running, no position
+    TEST_ASSERT_TRUE(clock.locked(uint32_t(source.now())));
+    TEST_ASSERT_FALSE(clock.running(uint32_t(source.now())));
+    TEST_ASSERT_FLOAT_WITHIN(0.0, 0.0, clock.beats(uint32_t(source.now())));
+
+    source.send(START);
+    source.play(120.0, 25);  // Beat 1 (first tick = beat 0)
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.0, clock.beats(uint32_t(source.now())));
+
+    source.send(STOP);
+    source.play(120.0, 24);  // Position held while stopped
+    TEST_ASSERT_FALSE(clock.running(uint32_t(source.now())));
+    source.send(CONTINUE);
+    source.play(120.0, 24);
+    TEST_ASSERT_TRUE(clock.running(uint32_t(source.now())));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 2.0, clock.beats(uint32_t(source.now())));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lock);
+    RUN_TEST(test_jitter_rejection);
+    RUN_TEST(test_tempo_change_tracked);
+    RUN_TEST(test_tempo_jump_relocks);
+    RUN_TEST(test_timeout);
+    RUN_TEST(test_transport);
+    return UNITY_END();
+}
@@ -0,0 +1,253 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of input::VerticalDebouncer (input/Debouncer.hpp)
+ *
+ * The bit-sliced debouncer is checked frame by frame against a per-button counter
+ * model (same semantics, one integer per button) on seeded bouncing input, for
+ * every supported debounce length and button counts that do not fill their last word.
+ *
+ * The benchmark times both on the same bouncing input, 8 to 256 buttons, 5-frame
+ * debounce, and reports the cost per scan.
+ *
+ * Run with: pio test -e native -f test_debouncer
+ */
+
+#include <unity.h>
+
+#include "input/Debouncer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using input::BitWords;
+using input::Edges;
+
+namespace {
+
+/**
+ * @brief Reference: a button changes state once its raw level differed from its
+ *        debounced state in `frames` consecutive frames
+ */
+template <size_t N>
+class CounterDebouncer {
+public:
+    explicit CounterDebouncer(uint32_t frames) : frames_(frames ? frames : 1) {}
+
+    Edges<N> update(const BitWords<N>& raw) {
+        Edges<N> edges;
+        for (size_t i = 0; i < N; ++i) {
+            const uint32_t mask = 1u << (i % 32);
+            const bool level = raw[i / 32] & mask;
+            if (level == pressed_[i]) {
+                counts_[i] = 0;
+            } else if (++counts_[i] >= frames_) {
+                counts_[i] = 0;
+                pressed_[i] = level;
+                (level ? edges.pressed : edges.released)[i / 32] |= mask;
+            }
+        }
+        return edges;
+    }
+
+    BitWords<N> state() const {
+        BitWords<N> words{};
+        for (size_t i = 0; i < N; ++i) words[i / 32] |= uint32_t(pressed_[i]) << (i % 32);
+        return words;
+    }
+
+private:
+    uint32_t frames_;
+    std::array<uint32_t, N> counts_{};
+    std::array<bool, N> pressed_{};
+};
+
+/// Seeded bouncing input: each button holds a level for a while, with bounce noise
+template <size_t N>
+class BouncyInput {
+public:
+    explicit BouncyInput(uint32_t seed) : rng_(seed) {}
+
+    BitWords<N> next() {
+        BitWords<N> raw{};
+        for (size_t i = 0; i < N; ++i) {
+            if (chance_(rng_) < 0.02) levels_[i] = !levels_[i];
+            const bool bounce = chance_(rng_) < 0.15;
+            if (levels_[i] != bounce) raw[i / 32] |= 1u << (i % 32);
+        }
+        return raw;
+    }
+
+private:
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> chance_{0.0, 1.0};
+    std::array<bool, N> levels_{};
+};
+
+template <size_t N, uint32_t Frames>
+void checkEquivalent(uint32_t seed, size_t frameCount) {
+    input::VerticalDebouncer<N, input::counterBits(Frames)> vertical(Frames);
+    CounterDebouncer<N> reference(Frames);
+    BouncyInput<N> input(seed);
+
+    size_t edgeCount = 0;
+    for (size_t frame = 0; frame < frameCount; ++frame) {
+        const BitWords<N> raw = input.next();
+        const Edges<N> got = vertical.update(raw);
+        const Edges<N> want = reference.update(raw);
+        TEST_ASSERT_TRUE(got.pressed == want.pressed);
+        TEST_ASSERT_TRUE(got.released == want.released);
+        TEST_ASSERT_TRUE(vertical.state() == reference.state());
+        if (got.any()) ++edgeCount;
+    }
+    TEST_ASSERT_TRUE(edgeCount > 0);  // The input did produce debounced changes
+}
+
+/// ns per update() of the vertical and the reference debouncer over the same frames
+template <size_t N>
+void benchmarkButtons() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t FRAMES = 5;
+    constexpr size_t UPDATES = 200'000;
+    BouncyInput<N> bouncy{uint32_t(N)};
+    std::vector<BitWords<N>> frames(1024);
+    for (BitWords<N>& frame : frames) frame = bouncy.next();
+
+    input::VerticalDebouncer<N, input::counterBits(FRAMES)> vertical(FRAMES);
+    uint32_t verticalEdges = 0;
+    const auto verticalStart = Clock::now();
+    for (size_t i = 0; i < UPDATES; ++i) verticalEdges += vertical.update(frames[i & 1023]).any();
+    const double verticalNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - verticalStart).count() / UPDATES;
+
+    CounterDebouncer<N> reference(FRAMES);
+    uint32_t referenceEdges = 0;
+    const auto referenceStart = Clock::now();
+    for (size_t i = 0; i < UPDATES; ++i) referenceEdges += reference.update(frames[i & 1023]).any();
+    const double referenceNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - referenceStart).count() / UPDATES;
+
+    TEST_ASSERT_TRUE(verticalEdges > 0);
+    TEST_ASSERT_EQUAL(referenceEdges, verticalEdges);
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "%3zu buttons: vertical %6.1f ns/scan, per-button counters %7.1f ns/scan "
+                  "(x%.1f) (host)",
+                  N, verticalNs, referenceNs, referenceNs / verticalNs);
+    TEST_MESSAGE(line);
+}
+
+template <size_t N>
+BitWords<N> only(size_t index) {
+    BitWords<N> raw{};
+    raw[index / 32] |= 1u << (index % 32);
+    return raw;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_equivalent_1_frame() { checkEquivalent<40, 1>(1, 5000); }
+void test_equivalent_2_frames() { checkEquivalent<40, 2>(2, 5000); }
+void test_equivalent_3_frames() { checkEquivalent<70, 3>(3, 5000); }
+void test_equivalent_4_frames() { checkEquivalent<70, 4>(4, 5000); }
+void test_equivalent_5_frames() { checkEquivalent<33, 5>(5, 5000); }
+void test_equivalent_8_frames() { checkEquivalent<64, 8>(8, 5000); }
+void test_equivalent_15_frames() { checkEquivalent<100, 15>(15, 5000); }
+
+void test_equivalent_default_width() {
+    // Bits = 4 with a short debounce: counter planes wider than needed
+    input::VerticalDebouncer<48> vertical(3);
+    CounterDebouncer<48> reference(3);
+    BouncyInput<48> input(42);
+    for (size_t frame = 0; frame < 5000; ++frame) {
+        const BitWords<48> raw = input.next();
+        TEST_ASSERT_TRUE(vertical.update(raw).pressed == reference.update(raw).pressed);
+        TEST_ASSERT_TRUE(vertical.state() == reference.state());
+    }
+}
+
+void test_glitch_shorter_than_frames() {
+    input::VerticalDebouncer<40, input::counterBits(4)> debouncer(4);
+    const BitWords<40> idle{};
+    const BitWords<40> held = only<40>(35);
+
+    for (int i = 0; i < 3; ++i) TEST_ASSERT_FALSE(debouncer.update(held).any());
+    TEST_ASSERT_FALSE(debouncer.update(idle).any());  // Count restarts
+    for (int i = 0; i < 3; ++i) TEST_ASSERT_FALSE(debouncer.update(held).any());
+
+    const Edges<40> edges = debouncer.update(held);
+    TEST_ASSERT_TRUE(edges.pressed == held);
+    TEST_ASSERT_TRUE(debouncer.state() == held);
+
+    for (int i = 0; i < 3; ++i) TEST_ASSERT_FALSE(debouncer.update(idle).any());
+    TEST_ASSERT_TRUE(debouncer.update(idle).released == held);
+}
+
+void test_frames_clamped() {
+    // 0 frames acts as 1, more than MAX_FRAMES as MAX_FRAMES
+    input::VerticalDebouncer<8, 2> fast(0);
+    TEST_ASSERT_TRUE(fast.update(only<8>(3)).any());
+
+    using Slow = input::VerticalDebouncer<8, 2>;
+    Slow slow(100);
+    for (uint32_t i = 1; i < Slow::MAX_FRAMES; ++i) {
+        TEST_ASSERT_FALSE(slow.update(only<8>(3)).any());
+    }
+    TEST_ASSERT_TRUE(slow.update(only<8>(3)).any());
+}
+
+void test_edges_for_each() {
+    Edges<70> edges;
+    edges.pressed[0] = 1u << 4;
+    edges.released[1] = 1u << 0;
+    edges.pressed[2] = 1u << 5;
+
+    std::array<size_t, 3> indices{};
+    std::array<bool, 3> pressed{};
+    size_t count = 0;
+    edges.forEach([&](size_t index, bool down) {
+        if (count < indices.size()) {
+            indices[count] = index;
+            pressed[count] = down;
+        }
+        ++count;
+    });
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_EQUAL(4, indices[0]);
+    TEST_ASSERT_EQUAL(32, indices[1]);
+    TEST_ASSERT_EQUAL(69, indices[2]);
+    TEST_ASSERT_TRUE(pressed[0] && !pressed[1] && pressed[2]);
+}
+
+void test_benchmark_8_to_256_buttons() {
+    benchmarkButtons<8>();
+    benchmarkButtons<32>();
+    benchmarkButtons<64>();
+    benchmarkButtons<128>();
+    benchmarkButtons<256>();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_equivalent_1_frame);
+    RUN_TEST(test_equivalent_2_frames);
+    RUN_TEST(test_equivalent_3_frames);
+    RUN_TEST(test_equivalent_4_frames);
+    RUN_TEST(test_equivalent_5_frames);
+    RUN_TEST(test_equivalent_8_frames);
+    RUN_TEST(test_equivalent_15_frames);
+    RUN_TEST(test_equivalent_default_width);
+    RUN_TEST(test_glitch_shorter_than_frames);
+    RUN_TEST(test_frames_clamped);
+    RUN_TEST(test_edges_for_each);
+    RUN_TEST(test_benchmark_8_to_256_buttons);
+    return UNITY_END();
+}
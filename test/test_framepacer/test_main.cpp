@@ -0,0 +1,310 @@
+/**
+ * @file test_main.cpp
+ * @brief Host simulation of frame pacing against a panel with its own clock (ui/FrameSchedule.hpp)
+ *
+ * The panel refreshes from its own oscillator (vsync period unlike the nominal
+ * 10 ms). Its driver holds a flush while the previous frame still waits for its
+ * vsync, then copies; a frame is shown at the first vsync after its flush ended.
+ * The loop is replayed the way FramePacer and main.cpp run it: due() polled every
+ * app tick (500 us, plus interrupt latency jitter), random render costs, a probe
+ * every PROBE_FRAMES frames, advance() after each frame.
+ *   - calibrate(): least-squares period from back-to-back frames, exact and with
+ *     jittery flush ends; rejected without vsync (nominal period kept)
+ *   - pacing: frames shown at their target vsync, flushes not held
+ *   - panel clock drift (+/-0.1 %) followed, phase relocked after an idle panel
+ *   - a blocked loop skips slots instead of queueing frames
+ *
+ * The last test compares pacing with frames started every 10 ms on the MCU clock
+ * (held flush time, render-to-display latency).
+ *
+ * Run with: pio test -e native -f test_framepacer
+ */
+
+#include <unity.h>
+
+#include "ui/FrameSchedule.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Config::Display / Config::LVGL defaults
+constexpr size_t CALIBRATION_FRAMES = 32;
+constexpr uint32_t PROBE_FRAMES = 128;
+constexpr ui::FrameTiming TIMING = {10'000.0, 700};
+constexpr uint32_t APP_PERIOD_US = 500;
+
+using Schedule = ui::FrameSchedule<CALIBRATION_FRAMES>;
+
+constexpr double PANEL_US = 1e6 / 96.4;  // A slow unit: 10 373.4 us
+constexpr uint32_t COPY_US = 1500;
+
+/**
+ * @brief Panel + driver: vsyncs on the panel clock, flushes held behind the frame
+ *        waiting for its vsync
+ */
+class Panel {
+public:
+    Panel(double periodUs, bool vsync = true) : period_(periodUs), vsync_(vsync) {}
+
+    /// Flush of a frame rendered until renderUs; returns the flush end
+    double flush(double renderUs, double copyUs = COPY_US) {
+        const double start = vsync_ ? std::max(renderUs, pending_) : renderUs;
+        heldUs_ = start - renderUs;
+        const double end = start + copyUs;
+        pending_ = shownUs_ = vsyncAt(end);
+        return end;
+    }
+
+    /// Panel oscillator change from the next vsync on
+    void setPeriod(double periodUs, double nowUs) {
+        anchor_ = vsyncAt(nowUs);
+        period_ = periodUs;
+    }
+
+    double shownUs() const { return shownUs_; }  ///< Vsync showing the last flushed frame
+    double heldUs() const { return heldUs_; }    ///< Time the last flush was held
+
+private:
+    /// First vsync at or after t
+    double vsyncAt(double t) const {
+        return anchor_ + std::ceil((t - anchor_) / period_) * period_;
+    }
+
+    double period_;
+    bool vsync_;
+    double anchor_ = 123.0;  ///< A vsync
+    double pending_ = 0.0;
+    double shownUs_ = 0.0;
+    double heldUs_ = 0.0;
+};
+
+/// FramePacer's calls in main.cpp's loop, on simulated time
+class Loop {
+public:
+    explicit Loop(Panel& panel, uint32_t seed = 47) : panel_(panel), rng_(seed) {}
+
+    /// Back-to-back full frames; flush ends off by up to endJitterUs
+    bool calibrate(double endJitterUs = 0.0) {
+        std::array<uint32_t, CALIBRATION_FRAMES> ends{};
+        std::array<uint32_t, CALIBRATION_FRAMES> flushes{};
+        std::uniform_real_distribution<double> jitter(0.0, endJitterUs);
+        uint32_t renderMax = 0;
+        for (size_t i = 0; i < CALIBRATION_FRAMES; ++i) {
+            const double render = nowUs_ + 4000.0;
+            nowUs_ = panel_.flush(render) + (endJitterUs > 0 ? jitter(rng_) : 0.0);
+            ends[i] = uint32_t(nowUs_);
+            flushes[i] = uint32_t(nowUs_) - uint32_t(render);
+            renderMax = std::max(renderMax, 4000u);
+        }
+        return schedule_.calibrate(ends.data(), flushes.data(), CALIBRATION_FRAMES, renderMax,
+                                   uint32_t(nowUs_));
+    }
+
+    /// App ticks for `us`; frames cost 1-3 ms to render, none while `idle`
+    void run(double us, bool idle = false) {
+        std::uniform_real_distribution<double> cost(1000.0, 3000.0);
+        std::uniform_real_distribution<double> latency(0.0, 40.0);
+        const double end = nowUs_ + us;
+        while (nowUs_ < end) {
+            nowUs_ = (std::floor(nowUs_ / APP_PERIOD_US) + 1) * APP_PERIOD_US + latency(rng_);
+            if (!schedule_.due(uint32_t(nowUs_))) continue;
+            if (!idle) frame(cost(rng_));
+            schedule_.advance(uint32_t(nowUs_));
+        }
+    }
+
+    /// The loop blocked for `us` (long handler work)
+    void block(double us) { nowUs_ += us; }
+
+    Schedule& schedule() { return schedule_; }
+    uint32_t shownOnTarget() const { return shownOnTarget_; }
+    double heldUs() const { return heldUs_; }
+    double latencyUs() const { return latencyUs_; }
+    uint32_t frames() const { return frames_; }
+
+    void resetCounts() {
+        shownOnTarget_ = frames_ = 0;
+        heldUs_ = latencyUs_ = 0.0;
+    }
+
+private:
+    void frame(double costUs) {
+        const uint32_t slot = schedule_.slotUs();
+        const uint32_t target = schedule_.vsyncUs();
+        const double start = nowUs_;
+        const double render = start + costUs;
+        nowUs_ = panel_.flush(render);
+        if (schedule_.frame(slot, uint32_t(start), uint32_t(render), uint32_t(nowUs_))) {
+            schedule_.observe(uint32_t(nowUs_));
+        }
+        ++frames_;
+        heldUs_ += panel_.heldUs();
+        latencyUs_ += panel_.shownUs() - render;
+        shownOnTarget_ += std::fabs(panel_.shownUs() - target) < PANEL_US / 2;
+
+        if (++sinceProbe_ < PROBE_FRAMES) return;
+        sinceProbe_ = 0;
+        const double probe = nowUs_ + 200.0;  // One pixel
+        nowUs_ = panel_.flush(probe);
+        schedule_.probe(uint32_t(probe), uint32_t(nowUs_));
+    }
+
+    Panel& panel_;
+    Schedule schedule_{TIMING};
+    std::mt19937 rng_;
+    double nowUs_ = 1'000'000.0;
+    uint32_t sinceProbe_ = 0;
+    uint32_t frames_ = 0;
+    uint32_t shownOnTarget_ = 0;
+    double heldUs_ = 0.0;
+    double latencyUs_ = 0.0;
+};
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_calibrate_exact() {
+    Panel panel(PANEL_US);
+    Loop loop(panel);
+    TEST_ASSERT_TRUE(loop.calibrate());
+    TEST_ASSERT_FLOAT_WITHIN(0.5, PANEL_US, loop.schedule().periodUs());
+    TEST_ASSERT_EQUAL(10373, loop.schedule().stats().periodUs);
+}
+
+void test_calibrate_jitter() {
+    // Flush ends up to 60 us late (interrupt latency on REFR_READY)
+    Panel panel(PANEL_US);
+    Loop loop(panel, 3);
+    TEST_ASSERT_TRUE(loop.calibrate(60.0));
+    TEST_ASSERT_FLOAT_WITHIN(3.0, PANEL_US, loop.schedule().periodUs());
+}
+
+void test_calibrate_rejects_no_vsync() {
+    // Driver without vsync: flushes never held, ends spaced by render + copy
+    Panel panel(PANEL_US, false);
+    Loop loop(panel);
+    TEST_ASSERT_FALSE(loop.calibrate());
+    TEST_ASSERT_FALSE(loop.schedule().stats().calibrated);
+    TEST_ASSERT_FLOAT_WITHIN(0.0, TIMING.nominalUs, loop.schedule().periodUs());
+}
+
+void test_paced_frames() {
+    Panel panel(PANEL_US);
+    Loop loop(panel);
+    loop.calibrate();
+    loop.run(30e6);  // 30 s, ~2900 frames
+    const Schedule::Stats& stats = loop.schedule().stats();
+    TEST_ASSERT_TRUE(loop.frames() > 2800);
+    TEST_ASSERT_TRUE(stats.missed <= 1);
+    TEST_ASSERT_EQUAL(0, stats.late);
+    TEST_ASSERT_EQUAL(0, stats.relocks);
+    TEST_ASSERT_TRUE(loop.shownOnTarget() >= loop.frames() - 1);
+    TEST_ASSERT_TRUE(loop.heldUs() / loop.frames() < 100.0);
+    TEST_ASSERT_FLOAT_WITHIN(1.0, PANEL_US, loop.schedule().periodUs());
+}
+
+void test_drift_followed() {
+    // Oscillator warming up or cooling down: +/-0.1 % (10 us per refresh)
+    for (double drift : {1.001, 0.999}) {
+        Panel panel(PANEL_US);
+        Loop loop(panel, 11);
+        loop.calibrate();
+        loop.run(5e6);
+        panel.setPeriod(PANEL_US * drift, 0.0);
+        loop.run(20e6);
+        loop.resetCounts();
+        const uint32_t missed = loop.schedule().stats().missed;
+        const uint32_t relocks = loop.schedule().stats().relocks;
+        loop.run(10e6);
+        TEST_ASSERT_FLOAT_WITHIN(1.0, PANEL_US * drift, loop.schedule().periodUs());
+        TEST_ASSERT_EQUAL(missed, loop.schedule().stats().missed);
+        TEST_ASSERT_EQUAL(relocks, loop.schedule().stats().relocks);
+        TEST_ASSERT_EQUAL(loop.frames(), loop.shownOnTarget());
+    }
+}
+
+void test_idle_then_relock() {
+    // 20 s without frames (no probes either) while the panel drifts by 20 ms: the
+    // first held flush afterwards relocks the phase
+    Panel panel(PANEL_US);
+    Loop loop(panel, 5);
+    loop.calibrate();
+    loop.run(2e6);
+    panel.setPeriod(PANEL_US * 1.001, 0.0);
+    loop.run(20e6, true);
+    const Schedule::Stats before = loop.schedule().stats();
+    loop.run(2e6);
+    TEST_ASSERT_TRUE(loop.schedule().stats().relocks > before.relocks);
+    loop.resetCounts();
+    loop.run(5e6);
+    TEST_ASSERT_TRUE(loop.schedule().stats().missed - before.missed <= 2);
+    TEST_ASSERT_EQUAL(loop.frames(), loop.shownOnTarget());
+}
+
+void test_blocked_loop_skips() {
+    Panel panel(PANEL_US);
+    Loop loop(panel);
+    loop.calibrate();
+    loop.run(1e6);
+    const uint32_t skipped = loop.schedule().stats().skipped;
+    loop.block(50'000);  // Five refreshes
+    loop.run(1e6);
+    TEST_ASSERT_TRUE(loop.schedule().stats().skipped - skipped >= 4);
+    loop.resetCounts();
+    loop.run(1e6);
+    TEST_ASSERT_EQUAL(loop.frames(), loop.shownOnTarget());
+}
+
+void test_report_paced_vs_fixed() {
+    Panel paced(PANEL_US);
+    Loop loop(paced);
+    loop.calibrate();
+    loop.run(2e6);
+    loop.resetCounts();
+    loop.run(20e6);
+
+    // Frames started every 10 ms on the MCU clock, same render costs
+    Panel fixed(PANEL_US);
+    std::mt19937 rng(47);
+    std::uniform_real_distribution<double> cost(1000.0, 3000.0);
+    double heldUs = 0.0;
+    double latencyUs = 0.0;
+    double now = 0.0;
+    uint32_t frames = 0;
+    for (double start = 1e6; start < 21e6; start += TIMING.nominalUs) {
+        const double render = std::max(start, now) + cost(rng);
+        now = fixed.flush(render);
+        heldUs += fixed.heldUs();
+        latencyUs += fixed.shownUs() - render;
+        ++frames;
+    }
+
+    char line[200];
+    std::snprintf(line, sizeof(line),
+                  "96.4 Hz panel: paced %.0f us held/frame, %.1f ms render-to-display; "
+                  "every 10 ms: %.0f us held/frame, %.1f ms (model)",
+                  loop.heldUs() / loop.frames(), loop.latencyUs() / loop.frames() / 1000.0,
+                  heldUs / frames, latencyUs / frames / 1000.0);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_calibrate_exact);
+    RUN_TEST(test_calibrate_jitter);
+    RUN_TEST(test_calibrate_rejects_no_vsync);
+    RUN_TEST(test_paced_frames);
+    RUN_TEST(test_drift_followed);
+    RUN_TEST(test_idle_then_relock);
+    RUN_TEST(test_blocked_loop_skips);
+    RUN_TEST(test_report_paced_vs_fixed);
+    return UNITY_END();
+}
@@ -0,0 +1,301 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of input::GestureEngine (input/GestureEngine.hpp)
+ *
+ * Button masks are played tick by tick (1 ms per tick, like a 1000 Hz app tick) into
+ * engines built from small test tables, with the Config timings:
+ *   - TAP alone, TAP delayed by a DOUBLE_TAP partner, DOUBLE_TAP
+ *   - LONG_PRESS (no TAP on release), HOLD_REPEAT period
+ *   - CHORD (consumes its buttons), SHIFT layers
+ *   - reset() (context switch): no gesture from buttons held or taps pending before it
+ *
+ * The benchmark runs 64 buttons with a TAP, DOUBLE_TAP and LONG_PRESS row each
+ * (192 rows) on random presses and reports the cost of a tick, busy and idle.
+ *
+ * Run with: pio test -e native -f test_gestures
+ */
+
+#include <unity.h>
+
+#include "input/GestureEngine.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using input::button;
+using input::ButtonMask;
+using input::Gesture;
+
+namespace {
+
+struct Row {
+    Gesture gesture;
+    ButtonMask buttons;
+    uint8_t layer;
+    int id;  ///< Reported when the row fires
+};
+
+constexpr input::GestureTiming TIMING = {500, 300, 100};  // Config::Timing values
+
+/// Plays button masks one millisecond per tick, collects the fired row ids
+template <size_t Rows>
+class Player {
+public:
+    explicit Player(const std::array<Row, Rows>& table) : engine_(table, TIMING) {}
+
+    /// Hold `pressed` for `ms` ticks
+    void hold(ButtonMask pressed, uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            engine_.update(pressed, nowMs_++, [this](const Row& row) {
+                fired_.push_back(row.id);
+                firedMs_.push_back(nowMs_ - 1);
+            });
+        }
+    }
+
+    const std::vector<int>& fired() const { return fired_; }
+    const std::vector<uint32_t>& firedMs() const { return firedMs_; }
+    const input::GestureEngine<Row, Rows>& engine() const { return engine_; }
+    void reset() { engine_.reset(); }
+    void clear() {
+        fired_.clear();
+        firedMs_.clear();
+    }
+
+private:
+    input::GestureEngine<Row, Rows> engine_;
+    uint32_t nowMs_ = 1000;
+    std::vector<int> fired_;
+    std::vector<uint32_t> firedMs_;
+};
+
+enum Id { TAP = 1, DOUBLE, LONG, REPEAT, CHORD, SHIFTED, PRESS };
+
+constexpr std::array<Row, 1> TAP_ONLY = {{{Gesture::TAP, button(0), 0, TAP}}};
+
+constexpr std::array<Row, 3> TAP_DOUBLE_LONG = {{
+    {Gesture::TAP, button(0), 0, TAP},
+    {Gesture::DOUBLE_TAP, button(0), 0, DOUBLE},
+    {Gesture::LONG_PRESS, button(0), 0, LONG},
+}};
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_tap() {
+    static constexpr auto table = TAP_ONLY;
+    Player<1> player(table);
+    player.hold(button(0), 100);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+    player.hold(0, 1);  // Released: a lone TAP fires at once
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+    TEST_ASSERT_EQUAL(TAP, player.fired()[0]);
+}
+
+void test_tap_too_long() {
+    static constexpr auto table = TAP_ONLY;
+    Player<1> player(table);
+    player.hold(button(0), TIMING.longPressMs);
+    player.hold(0, 400);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+}
+
+void test_tap_delayed_by_double_tap() {
+    static constexpr auto table = TAP_DOUBLE_LONG;
+    Player<3> player(table);
+    player.hold(button(0), 50);
+    player.hold(0, TIMING.doubleTapMs - 1);
+    TEST_ASSERT_EQUAL(0, player.fired().size());  // Still inside the window
+    player.hold(0, 10);
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+    TEST_ASSERT_EQUAL(TAP, player.fired()[0]);
+}
+
+void test_double_tap() {
+    static constexpr auto table = TAP_DOUBLE_LONG;
+    Player<3> player(table);
+    player.hold(button(0), 50);
+    player.hold(0, 100);
+    player.hold(button(0), 50);
+    player.hold(0, 1);
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+    TEST_ASSERT_EQUAL(DOUBLE, player.fired()[0]);
+    player.hold(0, 1000);  // No TAP afterwards
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+}
+
+void test_long_press() {
+    static constexpr auto table = TAP_DOUBLE_LONG;
+    Player<3> player(table);
+    player.hold(button(0), TIMING.longPressMs);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+    player.hold(button(0), 1000);
+    TEST_ASSERT_EQUAL(1, player.fired().size());  // Once
+    TEST_ASSERT_EQUAL(LONG, player.fired()[0]);
+    player.hold(0, 1000);  // Neither TAP nor DOUBLE_TAP on release
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+}
+
+void test_hold_repeat() {
+    static constexpr std::array<Row, 1> table = {{{Gesture::HOLD_REPEAT, button(5), 0, REPEAT}}};
+    Player<1> player(table);
+    player.hold(button(5), TIMING.longPressMs + 3 * TIMING.holdRepeatMs + 1);
+    TEST_ASSERT_EQUAL(4, player.fired().size());
+    for (size_t i = 1; i < player.firedMs().size(); ++i) {
+        TEST_ASSERT_EQUAL(TIMING.holdRepeatMs, player.firedMs()[i] - player.firedMs()[i - 1]);
+    }
+    player.hold(0, 500);
+    TEST_ASSERT_EQUAL(4, player.fired().size());
+}
+
+void test_chord() {
+    static constexpr std::array<Row, 3> table = {{
+        {Gesture::TAP, button(0), 0, TAP},
+        {Gesture::TAP, button(2), 0, TAP},
+        {Gesture::CHORD, button(0) | button(2), 0, CHORD},
+    }};
+    Player<3> player(table);
+    player.hold(button(0), 20);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+    player.hold(button(0) | button(2), 20);  // Chord complete
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+    TEST_ASSERT_EQUAL(CHORD, player.fired()[0]);
+    player.hold(button(2), 20);
+    player.hold(0, 500);  // Consumed: no TAP on release
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+
+    player.hold(button(2), 20);  // Released buttons tap again
+    player.hold(0, 1);
+    TEST_ASSERT_EQUAL(2, player.fired().size());
+    TEST_ASSERT_EQUAL(TAP, player.fired()[1]);
+}
+
+void test_shift_layer() {
+    static constexpr std::array<Row, 3> table = {{
+        {Gesture::SHIFT, button(1), 1, 0},
+        {Gesture::PRESS, button(0), 0, PRESS},
+        {Gesture::PRESS, button(0), 1, SHIFTED},
+    }};
+    Player<3> player(table);
+    player.hold(button(0), 10);
+    player.hold(0, 10);
+    player.hold(button(1), 10);
+    TEST_ASSERT_EQUAL(1, player.engine().layer());
+    player.hold(button(1) | button(0), 10);
+    player.hold(0, 10);
+    TEST_ASSERT_EQUAL(0, player.engine().layer());
+    TEST_ASSERT_EQUAL(2, player.fired().size());
+    TEST_ASSERT_EQUAL(PRESS, player.fired()[0]);
+    TEST_ASSERT_EQUAL(SHIFTED, player.fired()[1]);
+}
+
+void test_idle_early_out() {
+    static constexpr auto table = TAP_DOUBLE_LONG;
+    Player<3> player(table);
+    player.hold(0, 100);
+    TEST_ASSERT_EQUAL(100, player.engine().stats().idleTicks);
+    player.hold(button(0), 10);
+    player.hold(0, 10);  // Tap pending: not idle
+    TEST_ASSERT_EQUAL(100, player.engine().stats().idleTicks);
+    player.hold(0, TIMING.doubleTapMs + 10);
+    TEST_ASSERT_TRUE(player.engine().stats().idleTicks > 100);
+}
+
+namespace {
+constexpr size_t BENCH_BUTTONS = 64;
+
+constexpr std::array<Row, 3 * BENCH_BUTTONS> benchTable() {
+    std::array<Row, 3 * BENCH_BUTTONS> table{};
+    for (size_t b = 0; b < BENCH_BUTTONS; ++b) {
+        table[3 * b] = {Gesture::TAP, button(b), 0, TAP};
+        table[3 * b + 1] = {Gesture::DOUBLE_TAP, button(b), 0, DOUBLE};
+        table[3 * b + 2] = {Gesture::LONG_PRESS, button(b), 0, LONG};
+    }
+    return table;
+}
+
+constexpr auto BENCH_TABLE = benchTable();
+}  // namespace
+
+void test_benchmark_64_buttons() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t TICKS = 200'000;
+
+    // Random presses: each button toggles about once per 200 ms
+    std::mt19937 rng(39);
+    std::vector<ButtonMask> masks(TICKS);
+    ButtonMask pressed = 0;
+    for (ButtonMask& mask : masks) {
+        if (rng() % 4 == 0) pressed ^= button(rng() % BENCH_BUTTONS);
+        mask = pressed;
+    }
+
+    input::GestureEngine<Row, BENCH_TABLE.size()> busy(BENCH_TABLE, TIMING);
+    uint32_t fired = 0;
+    const auto start = Clock::now();
+    for (uint32_t t = 0; t < TICKS; ++t) busy.update(masks[t], t, [&](const Row&) { ++fired; });
+    const double busyNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - start).count() / TICKS;
+    TEST_ASSERT_TRUE(fired > 0);
+
+    input::GestureEngine<Row, BENCH_TABLE.size()> idle(BENCH_TABLE, TIMING);
+    const auto idleStart = Clock::now();
+    for (uint32_t t = 0; t < TICKS; ++t) idle.update(0, t, [&](const Row&) { ++fired; });
+    const double idleNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - idleStart).count() / TICKS;
+    TEST_ASSERT_EQUAL(TICKS, idle.stats().idleTicks);
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "64 buttons, %zu rows: %.1f ns/tick with buttons held, %.1f ns/tick idle "
+                  "(host)",
+                  BENCH_TABLE.size(), busyNs, idleNs);
+    TEST_MESSAGE(line);
+}
+
+void test_reset() {
+    static constexpr auto table = TAP_DOUBLE_LONG;
+    Player<3> player(table);
+    player.hold(button(0), 50);
+    player.reset();  // Held across the switch: the release is no tap
+    player.hold(0, 1000);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+
+    player.hold(button(0), 50);
+    player.hold(0, 100);
+    player.reset();  // Pending first tap: neither TAP nor DOUBLE_TAP
+    player.hold(0, 1000);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+
+    player.hold(button(0), TIMING.longPressMs - 100);
+    player.reset();  // Still held after it: a new press, long press timed from the reset
+    player.hold(button(0), 200);
+    TEST_ASSERT_EQUAL(0, player.fired().size());
+    player.hold(button(0), TIMING.longPressMs);
+    TEST_ASSERT_EQUAL(1, player.fired().size());
+    TEST_ASSERT_EQUAL(LONG, player.fired()[0]);
+    TEST_ASSERT_EQUAL(0, player.engine().layer());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tap);
+    RUN_TEST(test_tap_too_long);
+    RUN_TEST(test_tap_delayed_by_double_tap);
+    RUN_TEST(test_double_tap);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_hold_repeat);
+    RUN_TEST(test_chord);
+    RUN_TEST(test_shift_layer);
+    RUN_TEST(test_idle_early_out);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_benchmark_64_buttons);
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_main.cpp
+ * @brief Host simulation of key-matrix scanning (input/MatrixSequencer.hpp)
+ *
+ * A matrix without diodes is modelled electrically: the driven row reads every column
+ * connected to it through closed keys, so three keys on the corners of a rectangle
+ * make the fourth read as closed. Frames are scanned row by row as MatrixScanner's ISR
+ * does, and checked against the keys really pressed:
+ *   - 3-key L shapes (every orientation and place): their rows are held, no ghost key
+ *   - legal chords (diagonal, full row or column, rows on distinct columns) pass
+ *   - random presses: a row either reads exactly its keys or is held, never a ghost
+ *   - with diodes (no ghost detection) every frame is exact
+ *
+ * The benchmark reports the ISR cost of a frame for an 8x8 matrix with all keys down
+ * (worst case: every row pair goes through the ghost check), with and without it.
+ *
+ * Run with: pio test -e native -f test_matrix
+ */
+
+#include <unity.h>
+
+#include "input/MatrixSequencer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr size_t ROWS = 8;
+constexpr size_t COLS = 8;
+using Sequencer = input::MatrixSequencer<ROWS, COLS>;
+using RowBits = Sequencer::RowBits;
+
+/// Columns read while `row` is driven: everything connected to it through closed keys
+RowBits readMatrix(const RowBits& pressed) {
+    RowBits read{};
+    for (size_t r = 0; r < ROWS; ++r) {
+        uint32_t rows = 1u << r;
+        uint32_t cols = 0;
+        while (true) {  // Grow the connected set until it stops changing
+            uint32_t nextCols = cols;
+            for (size_t i = 0; i < ROWS; ++i) {
+                if ((rows >> i) & 1) nextCols |= pressed[i];
+            }
+            uint32_t nextRows = rows;
+            for (size_t i = 0; i < ROWS; ++i) {
+                if (pressed[i] & nextCols) nextRows |= 1u << i;
+            }
+            if (nextCols == cols && nextRows == rows) break;
+            cols = nextCols;
+            rows = nextRows;
+        }
+        read[r] = cols;
+    }
+    return read;
+}
+
+/// Rows of a frame
+RowBits rowsOf(const Sequencer::Frame& frame) {
+    RowBits rows{};
+    for (size_t r = 0; r < ROWS; ++r) rows[r] = (frame[r * COLS / 32] >> (r * COLS % 32)) & 0xFF;
+    return rows;
+}
+
+/// One frame: each row driven in turn, its columns read through the matrix
+Sequencer::Frame scan(Sequencer& sequencer, const RowBits& pressed, bool diodes = false) {
+    const RowBits read = diodes ? pressed : readMatrix(pressed);
+    while (!sequencer.sample(read[sequencer.row()])) {}
+    return sequencer.frame();
+}
+
+RowBits keys(std::initializer_list<std::pair<size_t, size_t>> list) {
+    RowBits rows{};
+    for (const auto& [r, c] : list) rows[r] |= 1u << c;
+    return rows;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_model_ghost() {
+    // The model itself: an L of three keys reads as the full rectangle
+    const RowBits read = readMatrix(keys({{1, 2}, {1, 5}, {4, 2}}));
+    TEST_ASSERT_EQUAL((1u << 2) | (1u << 5), read[1]);
+    TEST_ASSERT_EQUAL((1u << 2) | (1u << 5), read[4]);  // (4, 5) is a ghost
+}
+
+void test_l_shapes_masked() {
+    // Every 3-of-4 corner subset of every rectangle: the rows concerned keep their
+    // previous (empty) state, so the frame never shows the ghost key
+    for (size_t r0 = 0; r0 < ROWS; ++r0) {
+        for (size_t r1 = r0 + 1; r1 < ROWS; ++r1) {
+            for (size_t c0 = 0; c0 < COLS; ++c0) {
+                for (size_t c1 = c0 + 1; c1 < COLS; ++c1) {
+                    const std::array<std::pair<size_t, size_t>, 4> corners = {
+                        {{r0, c0}, {r0, c1}, {r1, c0}, {r1, c1}}};
+                    for (size_t missing = 0; missing < 4; ++missing) {
+                        RowBits pressed{};
+                        for (size_t k = 0; k < 4; ++k) {
+                            if (k != missing) pressed[corners[k].first] |= 1u << corners[k].second;
+                        }
+                        TEST_ASSERT_EQUAL((1u << r0) | (1u << r1),
+                                          Sequencer::ghostRows(readMatrix(pressed)));
+
+                        Sequencer sequencer;
+                        const RowBits frame = rowsOf(scan(sequencer, pressed));
+                        TEST_ASSERT_EQUAL(0, frame[r0]);
+                        TEST_ASSERT_EQUAL(0, frame[r1]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void test_held_rows_keep_last_state() {
+    // Two keys accepted, a third completes an L: rows hold, release clears it
+    Sequencer sequencer;
+    const RowBits two = keys({{0, 0}, {0, 3}});
+    TEST_ASSERT_TRUE(rowsOf(scan(sequencer, two)) == two);
+
+    const RowBits three = keys({{0, 0}, {0, 3}, {6, 3}});
+    const RowBits held = rowsOf(scan(sequencer, three));
+    TEST_ASSERT_TRUE(held == two);  // Row 6 not reported yet
+    TEST_ASSERT_EQUAL(1, sequencer.ghostFrames());
+
+    const RowBits after = keys({{0, 0}, {6, 3}});  // Ambiguity gone
+    TEST_ASSERT_TRUE(rowsOf(scan(sequencer, after)) == after);
+}
+
+void test_legal_chords_pass() {
+    const std::array<RowBits, 5> chords = {
+        keys({{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}, {6, 6}, {7, 7}}),  // Diagonal
+        keys({{0, 4}, {1, 4}, {2, 4}, {3, 4}, {4, 4}, {5, 4}, {6, 4}, {7, 4}}),  // Column
+        RowBits{0xFF, 0, 0, 0, 0, 0, 0, 0},                                       // Row
+        keys({{2, 0}, {2, 1}, {2, 2}, {5, 6}, {5, 7}}),  // Two rows on distinct columns
+        keys({{1, 3}, {4, 3}, {6, 5}, {6, 6}}),          // Shared column, disjoint row
+    };
+    for (const RowBits& chord : chords) {
+        TEST_ASSERT_EQUAL(0, Sequencer::ghostRows(readMatrix(chord)));
+        Sequencer sequencer;
+        TEST_ASSERT_TRUE(rowsOf(scan(sequencer, chord)) == chord);
+        TEST_ASSERT_EQUAL(0, sequencer.ghostFrames());
+    }
+}
+
+void test_random_presses_never_ghost() {
+    std::mt19937 rng(43);
+    Sequencer sequencer;
+    RowBits previous{};
+    uint32_t heldFrames = 0;
+    for (int frame = 0; frame < 20000; ++frame) {
+        RowBits pressed{};
+        const int count = int(rng() % 6);  // 0-5 keys down
+        for (int k = 0; k < count; ++k) pressed[rng() % ROWS] |= 1u << (rng() % COLS);
+
+        const uint32_t ghosts = Sequencer::ghostRows(readMatrix(pressed));
+        const RowBits got = rowsOf(scan(sequencer, pressed));
+        for (size_t r = 0; r < ROWS; ++r) {
+            if ((ghosts >> r) & 1) {
+                TEST_ASSERT_EQUAL(previous[r], got[r]);  // Held
+            } else {
+                TEST_ASSERT_EQUAL(pressed[r], got[r]);  // Exact: no ghost, no miss
+            }
+        }
+        heldFrames += ghosts != 0;
+        previous = got;
+    }
+    TEST_ASSERT_TRUE(heldFrames > 0);
+    TEST_ASSERT_EQUAL(heldFrames, sequencer.ghostFrames());
+}
+
+void test_diodes_exact() {
+    std::mt19937 rng(8);
+    Sequencer sequencer(false);
+    for (int frame = 0; frame < 2000; ++frame) {
+        RowBits pressed{};
+        for (uint32_t& row : pressed) row = rng() & 0xFF;
+        TEST_ASSERT_TRUE(rowsOf(scan(sequencer, pressed, true)) == pressed);
+    }
+    TEST_ASSERT_EQUAL(0, sequencer.ghostFrames());
+}
+
+void test_benchmark_frame() {
+    // Worst case: every key down, every row pair sharing columns
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t FRAMES = 200'000;
+    RowBits all{};
+    all.fill(0xFF);
+
+    // The ghost check runs in the frame-completing step: the difference between the
+    // two figures is what that step adds over the others
+    uint32_t frames = 0;
+    auto timeFrames = [&](Sequencer& sequencer) {
+        const auto start = Clock::now();
+        for (uint32_t f = 0; f < FRAMES; ++f) {
+            for (size_t r = 0; r < ROWS; ++r) frames += sequencer.sample(all[r]);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / FRAMES;
+    };
+    Sequencer checked(true);
+    Sequencer plain(false);
+    const double checkedNs = timeFrames(checked);
+    const double plainNs = timeFrames(plain);
+    TEST_ASSERT_EQUAL(2 * FRAMES, frames);
+    TEST_ASSERT_EQUAL(FRAMES, checked.ghostFrames());
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "8x8, all keys down: %.1f ns per frame of %zu ISR steps with ghost check, "
+                  "%.1f ns without (host)",
+                  checkedNs, ROWS, plainNs);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_model_ghost);
+    RUN_TEST(test_l_shapes_masked);
+    RUN_TEST(test_held_rows_keep_last_state);
+    RUN_TEST(test_legal_chords_pass);
+    RUN_TEST(test_random_presses_never_ghost);
+    RUN_TEST(test_diodes_exact);
+    RUN_TEST(test_benchmark_frame);
+    return UNITY_END();
+}
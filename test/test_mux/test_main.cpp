@@ -0,0 +1,263 @@
+/**
+ * @file test_main.cpp
+ * @brief Host simulation of multiplexed button scanning (input/MuxSequencer.hpp)
+ *
+ * A 74HC4067 model (output follows a new address after a settle time; drive() sets
+ * the address lines S0-S3 one after the other) is stepped the way MuxScanner's ISR
+ * does: sample the channel addressed one step ago, then address the next one.
+ *   - Gray order: each channel once per frame, one address line per step, so no
+ *     transient address on the bus (binary order has some)
+ *   - settle: with STEP_US above the settle time every frame is exact; below it a
+ *     press shows on the next channel (the Config::Button::Mux::STEP_US hint)
+ *   - frames -> VerticalDebouncer: one edge per bouncing press, within the debounce
+ *
+ * The benchmark reports the cost of one ISR step (4 muxes) and of the debounce
+ * done per app tick.
+ *
+ * Run with: pio test -e native -f test_mux
+ */
+
+#include <unity.h>
+
+#include "input/Debouncer.hpp"
+#include "input/MuxSequencer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr size_t MUXES = 4;
+using Sequencer = input::MuxSequencer<MUXES>;
+using Frame = Sequencer::Frame;
+constexpr size_t CHANNELS = Sequencer::CHANNELS;
+
+/// Config defaults: STEP_US = 20, DEBOUNCE_MS = 5, APP_HZ = 2000
+constexpr uint32_t STEP_US = 20;
+constexpr uint32_t FRAME_US = STEP_US * CHANNELS;
+constexpr uint32_t DEBOUNCE_FRAMES = 5000 / FRAME_US;
+constexpr uint32_t APP_PERIOD_US = 500;
+
+/**
+ * @brief Muxes on shared address lines: the outputs show the previous address until
+ *        `settleUs` after a change
+ */
+class MuxBank {
+public:
+    explicit MuxBank(uint32_t settleUs) : settleUs_(settleUs) {}
+
+    /// Address lines written S0 first, like MuxScanner::drive(); counts the transient
+    /// addresses (neither the old nor the new one) put on the bus
+    void drive(uint8_t channel, uint32_t nowUs) {
+        uint8_t address = current_;
+        for (uint8_t a = 0; a < 4; ++a) {
+            const uint8_t next = uint8_t((address & ~(1u << a)) | (channel & (1u << a)));
+            if (next != address && next != channel) ++transients_;
+            address = next;
+        }
+        if (channel == current_) return;
+        previous_ = current_;
+        current_ = channel;
+        changedUs_ = nowUs;
+    }
+
+    /// Signal levels (bit m = mux m pressed) at nowUs for button levels `pressed`
+    uint32_t read(const Frame& pressed, uint32_t nowUs) const {
+        const uint8_t shown = nowUs - changedUs_ < settleUs_ ? previous_ : current_;
+        uint32_t levels = 0;
+        for (size_t m = 0; m < MUXES; ++m) {
+            const size_t bit = m * CHANNELS + shown;
+            levels |= ((pressed[bit >> 5] >> (bit & 31)) & 1u) << m;
+        }
+        return levels;
+    }
+
+    uint32_t transients() const { return transients_; }
+
+private:
+    uint32_t settleUs_;
+    uint8_t current_ = 0;
+    uint8_t previous_ = 0;
+    uint32_t changedUs_ = 0;
+    uint32_t transients_ = 0;
+};
+
+/// MuxScanner::begin() + step() every STEP_US, one completed frame per call
+class Scanner {
+public:
+    explicit Scanner(uint32_t settleUs) : bank_(settleUs) { bank_.drive(sequencer_.channel(), 0); }
+
+    Frame scan(const Frame& pressed) {
+        while (true) {
+            nowUs_ += STEP_US;
+            const bool complete = sequencer_.sample(bank_.read(pressed, nowUs_));
+            bank_.drive(sequencer_.channel(), nowUs_);
+            if (complete) return sequencer_.frame();
+        }
+    }
+
+    const MuxBank& bank() const { return bank_; }
+    uint32_t nowUs() const { return nowUs_; }
+
+private:
+    Sequencer sequencer_;
+    MuxBank bank_;
+    uint32_t nowUs_ = 0;
+};
+
+Frame randomFrame(std::mt19937& rng) {
+    Frame frame{};
+    for (uint32_t& word : frame) word = uint32_t(rng());
+    return frame;
+}
+
+bool bitOf(const Frame& frame, size_t bit) { return (frame[bit >> 5] >> (bit & 31)) & 1u; }
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_gray_sequence() {
+    std::array<bool, CHANNELS> seen{};
+    for (uint8_t step = 0; step < CHANNELS; ++step) {
+        const uint8_t channel = Sequencer::channelAt(step);
+        TEST_ASSERT_TRUE(channel < CHANNELS);
+        TEST_ASSERT_FALSE(seen[channel]);
+        seen[channel] = true;
+        const uint8_t next = Sequencer::channelAt(uint8_t((step + 1) % CHANNELS));  // Wraps
+        TEST_ASSERT_EQUAL(1, __builtin_popcount(channel ^ next));
+    }
+}
+
+void test_no_transient_address() {
+    Scanner scanner(15);
+    for (int i = 0; i < 10; ++i) scanner.scan(Frame{});
+    TEST_ASSERT_EQUAL(0, scanner.bank().transients());
+
+    // Same bank stepped in binary order: several address lines change per step
+    MuxBank binary(15);
+    for (uint32_t step = 1; step <= 10 * CHANNELS; ++step) {
+        binary.drive(uint8_t(step % CHANNELS), step * STEP_US);
+    }
+    TEST_ASSERT_TRUE(binary.transients() >= 10 * 8);  // 8 of 16 steps change 2+ lines
+}
+
+void test_settled_frames_exact() {
+    std::mt19937 rng(41);
+    Scanner scanner(STEP_US - 2);
+    for (int i = 0; i < 500; ++i) {
+        const Frame pressed = randomFrame(rng);
+        TEST_ASSERT_TRUE(scanner.scan(pressed) == pressed);
+    }
+}
+
+void test_unsettled_shows_on_next_channel() {
+    // Settle time above STEP_US: each sample still shows the previous channel
+    Scanner scanner(STEP_US + 5);
+    Frame pressed{};
+    const size_t mux = 2;
+    const uint8_t step = 5;
+    const uint8_t channel = Sequencer::channelAt(step);
+    const uint8_t nextChannel = Sequencer::channelAt(step + 1);
+    pressed[(mux * CHANNELS + channel) >> 5] |= 1u << ((mux * CHANNELS + channel) & 31);
+
+    scanner.scan(pressed);
+    const Frame frame = scanner.scan(pressed);
+    TEST_ASSERT_FALSE(bitOf(frame, mux * CHANNELS + channel));
+    TEST_ASSERT_TRUE(bitOf(frame, mux * CHANNELS + nextChannel));
+}
+
+void test_debounced_press() {
+    // A bouncing press on one button: one press edge, one release edge
+    Scanner scanner(15);
+    input::VerticalDebouncer<Sequencer::BUTTONS, input::counterBits(DEBOUNCE_FRAMES)> debouncer(
+        DEBOUNCE_FRAMES);
+    std::mt19937 rng(7);
+    const size_t button = 3 * CHANNELS + 9;
+
+    uint32_t presses = 0;
+    uint32_t releases = 0;
+    uint32_t pressUs = 0;
+    uint32_t pressedAtUs = 0;
+    for (uint32_t frame = 0; frame < 400; ++frame) {
+        bool level = frame >= 100 && frame < 250;
+        if ((frame >= 100 && frame < 104) || (frame >= 250 && frame < 254)) level = rng() % 2;
+        if (frame == 104) pressUs = scanner.nowUs();
+
+        Frame pressed{};
+        if (level) pressed[button >> 5] |= 1u << (button & 31);
+        const input::Edges<Sequencer::BUTTONS> edges = debouncer.update(scanner.scan(pressed));
+        edges.forEach([&](size_t index, bool down) {
+            TEST_ASSERT_EQUAL(button, index);
+            if (down && !presses++) pressedAtUs = scanner.nowUs();
+            if (!down) ++releases;
+        });
+    }
+    TEST_ASSERT_EQUAL(1, presses);
+    TEST_ASSERT_EQUAL(1, releases);
+    // Stable from frame 104: reported after DEBOUNCE_FRAMES frames (+1 frame of scan)
+    TEST_ASSERT_TRUE(pressedAtUs - pressUs <= (DEBOUNCE_FRAMES + 1) * FRAME_US);
+}
+
+void test_benchmark_step_and_tick() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t STEPS = 1'600'000;
+
+    std::mt19937 rng(41);
+    std::array<uint32_t, 1024> levels{};
+    for (uint32_t& l : levels) l = rng() & ((1u << MUXES) - 1);
+
+    Sequencer sequencer;
+    uint32_t frames = 0;
+    uint32_t channels = 0;
+    const auto stepStart = Clock::now();
+    for (uint32_t i = 0; i < STEPS; ++i) {
+        frames += sequencer.sample(levels[i & 1023]);
+        channels += sequencer.channel();
+    }
+    const double stepNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - stepStart).count() / STEPS;
+    TEST_ASSERT_EQUAL(STEPS / CHANNELS, frames);
+    TEST_ASSERT_TRUE(channels > 0);
+
+    // App tick: the frames scanned in one APP_PERIOD_US (1.5625 on average), input
+    // changing every 32 frames
+    std::array<Frame, 64> scanned{};
+    for (Frame& f : scanned) f = randomFrame(rng);
+    input::VerticalDebouncer<Sequencer::BUTTONS, input::counterBits(DEBOUNCE_FRAMES)> debouncer(
+        DEBOUNCE_FRAMES);
+    constexpr uint32_t DEBOUNCED = 1'000'000;
+    uint32_t edges = 0;
+    const auto tickStart = Clock::now();
+    for (uint32_t i = 0; i < DEBOUNCED; ++i) {
+        edges += debouncer.update(scanned[(i >> 5) & 63]).any();
+    }
+    const double frameNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - tickStart).count() / DEBOUNCED;
+    TEST_ASSERT_TRUE(edges > 0);
+
+    char line[200];
+    std::snprintf(line, sizeof(line),
+                  "%zu muxes: ISR step %.1f ns (%u steps/s = %.1f us/s); app tick %.1f ns "
+                  "(%.2f frames of %zu buttons) (host)",
+                  MUXES, stepNs, 1'000'000 / STEP_US, stepNs * (1'000'000 / STEP_US) / 1000.0,
+                  frameNs * APP_PERIOD_US / FRAME_US, double(APP_PERIOD_US) / FRAME_US,
+                  Sequencer::BUTTONS);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gray_sequence);
+    RUN_TEST(test_no_transient_address);
+    RUN_TEST(test_settled_frames_exact);
+    RUN_TEST(test_unsettled_shows_on_next_channel);
+    RUN_TEST(test_debounced_press);
+    RUN_TEST(test_benchmark_step_and_tick);
+    return UNITY_END();
+}
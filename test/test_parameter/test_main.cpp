@@ -0,0 +1,192 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of the encoder parameter model (model/Parameter.hpp)
+ *
+ * For each curve and a few ranges/steps, over every position:
+ *   - output() is monotonic and hits min/max at the ends
+ *   - positionOf() of each reachable value gives that value back and is monotonic
+ *   - the detent snaps to the center only inside its zone
+ *
+ * Run with: pio test -e native -f test_parameter
+ */
+
+#include <unity.h>
+
+#include "model/Parameter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using model::Curve;
+using model::Parameter;
+using model::ParamDef;
+using model::Position;
+using model::POSITION_CENTER;
+using model::POSITION_MAX;
+
+namespace {
+
+constexpr std::array<Curve, 3> CURVES = {Curve::LINEAR, Curve::LOG, Curve::EXP};
+
+/// Ranges/steps under test, curve filled in per run
+constexpr std::array<ParamDef, 5> DEFS = {{
+    {0, 127, 1, 0, Curve::LINEAR},    // Plain CC
+    {0, 127, 8, 0, Curve::LINEAR},    // 16 values, span a multiple of step
+    {0, 127, 10, 0, Curve::LINEAR},   // Span not a multiple of step
+    {-64, 63, 1, 0, Curve::LINEAR},   // Negative minimum
+    {10, 13, 1, 0, Curve::LINEAR},    // Few values: wide position ranges
+}};
+
+ParamDef withCurve(ParamDef def, Curve curve) {
+    def.curve = curve;
+    return def;
+}
+
+/// Every output value reached by some position, in increasing order
+std::vector<int32_t> reachableValues(const Parameter& param) {
+    std::vector<int32_t> values;
+    for (uint32_t p = 0; p <= POSITION_MAX; ++p) {
+        const int32_t value = param.output(Position(p));
+        if (values.empty() || values.back() != value) values.push_back(value);
+    }
+    return values;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_output_monotonic() {
+    for (Curve curve : CURVES) {
+        for (const ParamDef& def : DEFS) {
+            const Parameter param(withCurve(def, curve));
+            int32_t previous = param.output(0);
+            for (uint32_t p = 1; p <= POSITION_MAX; ++p) {
+                const int32_t value = param.output(Position(p));
+                TEST_ASSERT_TRUE(value >= previous);
+                previous = value;
+            }
+        }
+    }
+}
+
+void test_output_endpoints() {
+    for (Curve curve : CURVES) {
+        for (const ParamDef& def : DEFS) {
+            const Parameter param(withCurve(def, curve));
+            TEST_ASSERT_EQUAL(def.min, param.output(0));
+            const int32_t top = param.output(POSITION_MAX);
+            TEST_ASSERT_TRUE(top <= def.max);
+            TEST_ASSERT_TRUE(def.max - top < def.step);  // Last step that fits the range
+            if ((def.max - def.min) % def.step == 0) TEST_ASSERT_EQUAL(def.max, top);
+        }
+    }
+}
+
+void test_output_on_step_grid() {
+    for (Curve curve : CURVES) {
+        for (const ParamDef& def : DEFS) {
+            const Parameter param(withCurve(def, curve));
+            for (int32_t value : reachableValues(param)) {
+                TEST_ASSERT_EQUAL(0, (value - def.min) % def.step);
+            }
+        }
+    }
+}
+
+void test_position_of_round_trip() {
+    for (Curve curve : CURVES) {
+        for (const ParamDef& def : DEFS) {
+            const Parameter param(withCurve(def, curve));
+            for (int32_t value : reachableValues(param)) {
+                TEST_ASSERT_EQUAL(value, param.output(param.positionOf(value)));
+            }
+        }
+    }
+}
+
+void test_position_of_monotonic() {
+    for (Curve curve : CURVES) {
+        for (const ParamDef& def : DEFS) {
+            const Parameter param(withCurve(def, curve));
+            Position previous = param.positionOf(def.min - 1);
+            TEST_ASSERT_EQUAL(0, previous);
+            for (int32_t value = def.min; value <= def.max + 1; ++value) {
+                const Position position = param.positionOf(value);
+                TEST_ASSERT_TRUE(position >= previous);
+                previous = position;
+            }
+            TEST_ASSERT_EQUAL(POSITION_MAX, previous);
+        }
+    }
+}
+
+void test_position_of_inside_value_range() {
+    // positionOf() lands strictly inside the positions giving that value (not on an edge)
+    for (Curve curve : CURVES) {
+        const Parameter param(withCurve(DEFS[4], curve));
+        for (int32_t value : reachableValues(param)) {
+            const Position position = param.positionOf(value);
+            if (position > 0) TEST_ASSERT_EQUAL(value, param.output(Position(position - 1)));
+            if (position < POSITION_MAX) {
+                TEST_ASSERT_EQUAL(value, param.output(Position(position + 1)));
+            }
+        }
+    }
+}
+
+void test_detent() {
+    constexpr uint16_t DETENT = 2048;
+    for (Curve curve : CURVES) {
+        const Parameter param(ParamDef{0, 127, 1, DETENT, curve});
+        const int32_t center = param.output(POSITION_CENTER);
+        for (int32_t offset : {-int32_t(DETENT), -1, 0, 1, int32_t(DETENT)}) {
+            const auto value = param.apply(Position(POSITION_CENTER + offset));
+            TEST_ASSERT_EQUAL(POSITION_CENTER, value.position);
+            TEST_ASSERT_EQUAL(center, value.output);
+        }
+        for (int32_t offset : {-int32_t(DETENT) - 1, int32_t(DETENT) + 1}) {
+            const Position raw = Position(POSITION_CENTER + offset);
+            const auto value = param.apply(raw);
+            TEST_ASSERT_EQUAL(raw, value.position);
+            TEST_ASSERT_EQUAL(param.output(raw), value.output);
+        }
+        TEST_ASSERT_EQUAL(0, param.apply(0).output);
+        TEST_ASSERT_EQUAL(127, param.apply(POSITION_MAX).output);
+    }
+}
+
+void test_curve_shapes() {
+    // At mid travel EXP stays low, LOG high, LINEAR in the middle
+    const int32_t linear = Parameter(withCurve(DEFS[0], Curve::LINEAR)).output(POSITION_CENTER);
+    const int32_t log = Parameter(withCurve(DEFS[0], Curve::LOG)).output(POSITION_CENTER);
+    const int32_t exp = Parameter(withCurve(DEFS[0], Curve::EXP)).output(POSITION_CENTER);
+    TEST_ASSERT_EQUAL(64, linear);
+    TEST_ASSERT_TRUE(exp < linear && linear < log);
+    TEST_ASSERT_EQUAL(127, exp + log);  // LOG mirrors EXP
+}
+
+void test_normalized_boundary() {
+    TEST_ASSERT_EQUAL(0, model::toPosition(-0.5f));
+    TEST_ASSERT_EQUAL(POSITION_MAX, model::toPosition(1.5f));
+    for (uint32_t p = 0; p <= POSITION_MAX; p += 257) {
+        TEST_ASSERT_EQUAL(p, model::toPosition(model::toNormalized(Position(p))));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_output_monotonic);
+    RUN_TEST(test_output_endpoints);
+    RUN_TEST(test_output_on_step_grid);
+    RUN_TEST(test_position_of_round_trip);
+    RUN_TEST(test_position_of_monotonic);
+    RUN_TEST(test_position_of_inside_value_range);
+    RUN_TEST(test_detent);
+    RUN_TEST(test_curve_shapes);
+    RUN_TEST(test_normalized_boundary);
+    return UNITY_END();
+}
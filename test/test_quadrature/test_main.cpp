@@ -0,0 +1,283 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of the quadrature counting stages (input/QuadTracker.hpp)
+ *
+ * A/B edge sequences (clean, bouncing, reversing) go through the ENC counter model,
+ * are read back the way QuadDecoder::poll() does (counterDelta() at random tick
+ * intervals) and turned into positions by QuadTracker. The input filter register is
+ * checked at the bus clocks the Governor switches between (retime path).
+ *
+ * The benchmark times the software work of both backends per second of fast turning:
+ * one x4 decode per edge (what a pin-change ISR does, interrupt entry/exit not
+ * included) against one counter read + QuadTracker::update() per app tick.
+ *
+ * Run with: pio test -e native -f test_quadrature
+ */
+
+#include <unity.h>
+
+#include "input/QuadTracker.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+using input::QuadCounter;
+using input::QuadTracker;
+
+namespace {
+
+/// Gray sequence counting up (A then B rising)
+constexpr bool PHASE_A[4] = {false, true, true, false};
+constexpr bool PHASE_B[4] = {false, false, true, true};
+
+/**
+ * @brief Rotating encoder: drives QuadCounter one edge at a time; a bouncing edge
+ *        toggles the changing phase back and forth before settling
+ */
+class Encoder {
+public:
+    explicit Encoder(QuadCounter& counter) : counter_(counter) {}
+
+    /// One edge up (+1) or down (-1), with `bounces` extra back-and-forth toggles
+    void edge(int direction, int bounces = 0) {
+        const uint8_t next = uint8_t((phase_ + (direction > 0 ? 1 : 3)) & 3);
+        for (int i = 0; i < bounces; ++i) {
+            feed(next);
+            feed(phase_);
+        }
+        feed(next);
+        phase_ = next;
+    }
+
+    void turn(int edges, int bounces = 0) {
+        const int direction = edges < 0 ? -1 : 1;
+        for (int i = 0; i < edges * direction; ++i) edge(direction, bounces);
+    }
+
+private:
+    void feed(uint8_t phase) { counter_.update(PHASE_A[phase], PHASE_B[phase]); }
+
+    QuadCounter& counter_;
+    uint8_t phase_ = 0;
+};
+
+/// The read side of QuadDecoder::poll() for one encoder
+struct Reader {
+    QuadTracker tracker;
+    uint32_t last = 0;
+    uint32_t moves = 0;
+
+    void poll(const QuadCounter& counter) {
+        const int32_t delta = input::counterDelta(counter.position(), last);
+        if (delta == 0) return;
+        last = counter.position();
+        moves += tracker.update(delta);
+    }
+};
+
+/// Config::Encoder defaults: 24 ppr over 270 degrees
+constexpr uint16_t PPR = 24;
+constexpr uint16_t RANGE = 270;
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_counter_directions() {
+    QuadCounter counter;
+    Encoder encoder(counter);
+    encoder.turn(4 * 10);  // 10 cycles of 4 edges
+    TEST_ASSERT_EQUAL(40, int32_t(counter.position()));
+    encoder.turn(-4 * 15);
+    TEST_ASSERT_EQUAL(-20, int32_t(counter.position()));
+    TEST_ASSERT_EQUAL(0, counter.illegal());
+}
+
+void test_counter_illegal_transition() {
+    QuadCounter counter;
+    counter.update(true, true);  // 00 -> 11: both phases at once
+    TEST_ASSERT_EQUAL(0, counter.position());
+    TEST_ASSERT_EQUAL(1, counter.illegal());
+    counter.update(false, true);  // 11 -> 01: counts from the new state
+    TEST_ASSERT_EQUAL(1, counter.position());
+}
+
+void test_counter_bounce_nets_out() {
+    QuadCounter clean;
+    QuadCounter bouncy;
+    Encoder a(clean);
+    Encoder b(bouncy);
+    for (int bounces : {0, 1, 3, 7}) {
+        a.turn(37);
+        b.turn(37, bounces);
+        a.turn(-11);
+        b.turn(-11, bounces);
+        TEST_ASSERT_EQUAL(clean.position(), bouncy.position());
+    }
+    TEST_ASSERT_EQUAL(0, bouncy.illegal());
+}
+
+void test_counter_wrap() {
+    QuadCounter counter;
+    counter.preset(0xFFFFFFFEu);
+    Reader reader{QuadTracker(PPR, RANGE, 1, false), counter.position()};
+    reader.tracker.setPosition(model::POSITION_CENTER);
+
+    Encoder encoder(counter);
+    encoder.turn(5);  // Through 0xFFFFFFFF -> 0
+    TEST_ASSERT_EQUAL(3, counter.position());
+    TEST_ASSERT_EQUAL(5, input::counterDelta(counter.position(), reader.last));
+    reader.poll(counter);
+    const int32_t step = QuadTracker::eventStep(PPR, RANGE, 1);
+    TEST_ASSERT_EQUAL(model::POSITION_CENTER + 5 * step, reader.tracker.position());
+}
+
+void test_tracker_scale() {
+    // One turn of 4 * ppr counts covers 360 / RANGE of the position range
+    QuadTracker tracker(PPR, RANGE, 1, false);
+    tracker.update(4 * PPR * RANGE / 360);  // 72 counts: the whole range
+    const int32_t step = QuadTracker::eventStep(PPR, RANGE, 1);
+    TEST_ASSERT_TRUE(model::POSITION_MAX - tracker.position() < step);
+    TEST_ASSERT_TRUE(tracker.update(1000));  // Clamped at the top
+    TEST_ASSERT_EQUAL(model::POSITION_MAX, tracker.position());
+    TEST_ASSERT_FALSE(tracker.update(1000));
+    tracker.update(-100000);
+    TEST_ASSERT_EQUAL(0, tracker.position());
+}
+
+void test_tracker_reversal_mid_detent() {
+    // 4 counts per event: a partial turn and back moves nothing
+    QuadTracker tracker(PPR, RANGE, 4, false);
+    tracker.setPosition(model::POSITION_CENTER);
+    TEST_ASSERT_FALSE(tracker.update(3));
+    TEST_ASSERT_FALSE(tracker.update(-3));
+    TEST_ASSERT_EQUAL(model::POSITION_CENTER, tracker.position());
+
+    // One detent and a half, then back: ends where it started
+    TEST_ASSERT_TRUE(tracker.update(6));
+    TEST_ASSERT_TRUE(tracker.update(-6));
+    TEST_ASSERT_EQUAL(model::POSITION_CENTER, tracker.position());
+}
+
+void test_tracker_invert() {
+    QuadTracker normal(PPR, RANGE, 1, false);
+    QuadTracker inverted(PPR, RANGE, 1, true);
+    normal.setPosition(model::POSITION_CENTER);
+    inverted.setPosition(model::POSITION_CENTER);
+    normal.update(10);
+    inverted.update(-10);
+    TEST_ASSERT_EQUAL(normal.position(), inverted.position());
+}
+
+void test_polled_sequences() {
+    // Random walks with bounce and reversals, polled at random tick intervals: the
+    // position is the sum of the counts, minus less than one event in progress
+    std::mt19937 rng(44);
+    for (uint8_t ticks : {1, 2, 4}) {
+        QuadCounter counter;
+        Encoder encoder(counter);
+        Reader reader{QuadTracker(PPR, RANGE, ticks, false)};
+        reader.tracker.setPosition(model::POSITION_CENTER);
+        const int32_t step = QuadTracker::eventStep(PPR, RANGE, ticks);
+
+        int32_t total = 0;
+        for (int burst = 0; burst < 2000; ++burst) {
+            const int direction = rng() % 2 ? 1 : -1;
+            const int edges = int(rng() % 6) + 1;
+            const int bounces = int(rng() % 3);
+            encoder.turn(direction * edges, bounces);
+            total += direction * edges;
+            if (total > 30 || total < -30) {  // Stay clear of the clamps (72 counts in all)
+                encoder.turn(-direction * edges);
+                total -= direction * edges;
+            }
+            if (rng() % 3 == 0) reader.poll(counter);
+        }
+        reader.poll(counter);
+
+        const int32_t moved = int32_t(reader.tracker.position()) - model::POSITION_CENTER;
+        TEST_ASSERT_EQUAL(0, moved % step);
+        const int32_t events = moved / step;
+        TEST_ASSERT_TRUE(events * ticks - total < ticks && total - events * ticks < ticks);
+        TEST_ASSERT_TRUE(reader.moves > 0);
+    }
+}
+
+void test_retime_filter() {
+    // Bus clocks of the Governor's core clocks (IPG = core / 4 up to 600 MHz); the
+    // sample window stays at 15 us minus less than one sample period
+    for (uint32_t busHz : {150'000'000u, 112'500'000u, 37'500'000u, 24'000'000u, 6'000'000u}) {
+        const uint16_t filt = input::quadFilter(busHz);
+        TEST_ASSERT_EQUAL(input::QUAD_FILTER_COUNT, filt >> 8);
+        const uint32_t period = filt & 0xFF;
+        const uint64_t windowNs = uint64_t(input::QUAD_FILTER_COUNT + 3) * period *
+                                  1'000'000'000ull / busHz;
+        TEST_ASSERT_TRUE(windowNs <= 10 * input::QUAD_FILTER_SAMPLE_NS);
+        const uint64_t periodNs = 1'000'000'000ull / busHz;
+        TEST_ASSERT_TRUE(windowNs + 10 * periodNs >= 10 * input::QUAD_FILTER_SAMPLE_NS);
+    }
+    TEST_ASSERT_EQUAL(255, input::quadFilter(600'000'000u) & 0xFF);  // Clamped
+    TEST_ASSERT_EQUAL(1, input::quadFilter(100'000u) & 0xFF);
+}
+
+void test_benchmark_backends() {
+    // One second of fast turning: 5 turns/s of a 24 ppr encoder = 480 edges, app tick
+    // at 2000 Hz. Software cost only, measured on the host
+    constexpr int EDGES_PER_SEC = 5 * 4 * PPR;
+    constexpr int TICKS_PER_SEC = 2000;
+    constexpr int SECONDS = 2000;
+    using Clock = std::chrono::steady_clock;
+
+    QuadCounter isrCounter;
+    Encoder isrEncoder(isrCounter);
+    const auto isrStart = Clock::now();
+    for (int s = 0; s < SECONDS; ++s) isrEncoder.turn(s % 2 ? -EDGES_PER_SEC : EDGES_PER_SEC);
+    const double isrNs = std::chrono::duration<double, std::nano>(Clock::now() - isrStart).count();
+
+    // Counter values the ENC peripheral would hold at each tick
+    QuadCounter hwCounter;
+    Reader reader{QuadTracker(PPR, RANGE, 1, false)};
+    uint32_t position = 0;
+    const auto pollStart = Clock::now();
+    for (int s = 0; s < SECONDS; ++s) {
+        for (int t = 0; t < TICKS_PER_SEC; ++t) {
+            const int edges =
+                (t + 1) * EDGES_PER_SEC / TICKS_PER_SEC - t * EDGES_PER_SEC / TICKS_PER_SEC;
+            position += uint32_t(s % 2 ? -edges : edges);
+            hwCounter.preset(position);
+            reader.poll(hwCounter);
+        }
+    }
+    const double pollNs =
+        std::chrono::duration<double, std::nano>(Clock::now() - pollStart).count();
+    TEST_ASSERT_EQUAL(0, int32_t(isrCounter.position()));  // Even SECONDS: back to 0
+    TEST_ASSERT_TRUE(reader.moves > 0);
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "%d edges/s: per-edge decode %.1f ns/edge = %.2f us/s; "
+                  "%d polls/s: %.1f ns/poll = %.2f us/s (host)",
+                  EDGES_PER_SEC, isrNs / (double(SECONDS) * EDGES_PER_SEC),
+                  isrNs / SECONDS / 1000.0, TICKS_PER_SEC,
+                  pollNs / (double(SECONDS) * TICKS_PER_SEC), pollNs / SECONDS / 1000.0);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counter_directions);
+    RUN_TEST(test_counter_illegal_transition);
+    RUN_TEST(test_counter_bounce_nets_out);
+    RUN_TEST(test_counter_wrap);
+    RUN_TEST(test_tracker_scale);
+    RUN_TEST(test_tracker_reversal_mid_detent);
+    RUN_TEST(test_tracker_invert);
+    RUN_TEST(test_polled_sequences);
+    RUN_TEST(test_retime_filter);
+    RUN_TEST(test_benchmark_backends);
+    return UNITY_END();
+}
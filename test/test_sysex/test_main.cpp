@@ -0,0 +1,268 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of SysEx framing (midi/SysEx.hpp) and the state dump payload
+ *        (model/StateDump.hpp)
+ *
+ * Run with: pio test -e native -f test_sysex
+ */
+
+#include <unity.h>
+
+#include "midi/SysEx.hpp"
+#include "model/StateDump.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t MANUFACTURER = 0x7D;
+constexpr uint8_t DEVICE = 0x03;
+constexpr uint8_t COMMAND = 0x02;
+constexpr size_t CAPACITY = 32;
+
+using Decoder = midi::sysex::Decoder<CAPACITY>;
+using Result = Decoder::Result;
+
+/// Payload mixing bytes with and without their MSB set
+std::vector<uint8_t> payloadOf(size_t size) {
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) payload[i] = uint8_t(i * 37 + (i % 2 ? 0x80 : 0x05));
+    return payload;
+}
+
+std::vector<uint8_t> encode(const std::vector<uint8_t>& payload, uint8_t device = DEVICE) {
+    std::vector<uint8_t> message(midi::sysex::messageSize(payload.size()));
+    const size_t size = midi::sysex::encode(MANUFACTURER, device, COMMAND, payload.data(),
+                                            payload.size(), message.data());
+    message.resize(size);
+    return message;
+}
+
+/// Feed a message 3 bytes at a time (as USB-MIDI packets carry it), return the last result
+Result feed(Decoder& decoder, const std::vector<uint8_t>& message) {
+    Result result = Result::IGNORED;
+    for (size_t i = 0; i < message.size(); i += 3) {
+        const size_t count = message.size() - i < 3 ? message.size() - i : 3;
+        result = decoder.feed(message.data() + i, count);
+    }
+    return result;
+}
+
+void checkRoundTrip(size_t size) {
+    const std::vector<uint8_t> payload = payloadOf(size);
+    const std::vector<uint8_t> message = encode(payload);
+
+    TEST_ASSERT_EQUAL(midi::sysex::messageSize(size), message.size());
+    TEST_ASSERT_EQUAL(midi::sysex::START, message.front());
+    TEST_ASSERT_EQUAL(midi::sysex::END, message.back());
+    for (size_t i = 1; i + 1 < message.size(); ++i) TEST_ASSERT_TRUE(message[i] < 0x80);
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::COMPLETE), int(feed(decoder, message)));
+    TEST_ASSERT_EQUAL(COMMAND, decoder.command());
+    TEST_ASSERT_EQUAL(size, decoder.size());
+    if (size) TEST_ASSERT_EQUAL_UINT8_ARRAY(payload.data(), decoder.payload(), size);
+    TEST_ASSERT_EQUAL(1, decoder.stats().messages);
+    TEST_ASSERT_EQUAL(0, decoder.stats().errors);
+}
+
+/// Minimal State for StateDump: 2 banks of 3 encoders, 10 buttons
+struct FakeState {
+    static constexpr size_t SLOT_COUNT = 6;
+    static constexpr size_t BUTTON_COUNT = 10;
+
+    std::array<uint16_t, SLOT_COUNT> slots{};
+    std::array<bool, BUTTON_COUNT> buttons{};
+
+    uint16_t slot(size_t i) const { return slots[i]; }
+    void setSlot(size_t i, uint16_t position) { slots[i] = position; }
+    bool button(size_t i) const { return buttons[i]; }
+    void setButton(size_t i, bool pressed) { buttons[i] = pressed; }
+};
+
+using Dump = model::StateDump<FakeState>;
+static_assert(Dump::BYTES <= CAPACITY, "Dump must fit the test decoder");
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Framing and packing
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_packed_size() {
+    TEST_ASSERT_EQUAL(0, midi::sysex::packedSize(0));
+    TEST_ASSERT_EQUAL(2, midi::sysex::packedSize(1));
+    TEST_ASSERT_EQUAL(8, midi::sysex::packedSize(7));
+    TEST_ASSERT_EQUAL(10, midi::sysex::packedSize(8));
+    TEST_ASSERT_EQUAL(6, midi::sysex::messageSize(0));
+}
+
+void test_round_trip_empty() { checkRoundTrip(0); }
+void test_round_trip_1_byte() { checkRoundTrip(1); }
+void test_round_trip_7_bytes() { checkRoundTrip(7); }
+void test_round_trip_8_bytes() { checkRoundTrip(8); }
+void test_round_trip_capacity() { checkRoundTrip(CAPACITY); }
+
+void test_checksum_sums_to_zero() {
+    for (size_t size : {0, 1, 7, 8, 15}) {
+        const std::vector<uint8_t> message = encode(payloadOf(size));
+        uint32_t sum = 0;
+        for (size_t i = 3; i + 1 < message.size(); ++i) sum += message[i];  // Command..checksum
+        TEST_ASSERT_EQUAL(0, sum & 0x7F);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Decoder errors
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_bad_checksum() {
+    std::vector<uint8_t> message = encode(payloadOf(8));
+    message[message.size() - 2] ^= 0x01;
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::ERROR), int(feed(decoder, message)));
+    TEST_ASSERT_EQUAL(1, decoder.stats().errors);
+    TEST_ASSERT_EQUAL(0, decoder.stats().messages);
+}
+
+void test_bad_data_byte() {
+    std::vector<uint8_t> message = encode(payloadOf(7));
+    message[6] ^= 0x10;  // A packed byte, checksum unchanged
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::ERROR), int(feed(decoder, message)));
+}
+
+void test_truncated_before_end() {
+    // Every message cut short of one of its bytes (F7 kept) is rejected
+    const std::vector<uint8_t> full = encode(payloadOf(8));
+    for (size_t cut = 1; cut + 1 < full.size(); ++cut) {
+        std::vector<uint8_t> message = full;
+        message.erase(message.begin() + cut);
+
+        Decoder decoder(MANUFACTURER, DEVICE);
+        const Result result = feed(decoder, message);
+        TEST_ASSERT_TRUE(result == Result::ERROR || result == Result::IGNORED);
+        TEST_ASSERT_EQUAL(0, decoder.stats().messages);
+    }
+}
+
+void test_group_without_data() {
+    // An MSB byte with no data byte after it: checksum still matches (0 adds nothing)
+    std::vector<uint8_t> message = encode(payloadOf(7));
+    message.insert(message.end() - 2, 0x00);
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::ERROR), int(feed(decoder, message)));
+}
+
+void test_no_command() {
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::ERROR),
+                      int(feed(decoder, {midi::sysex::START, MANUFACTURER, DEVICE,
+                                         midi::sysex::END})));
+}
+
+void test_truncated_then_restarted() {
+    // A message missing its F7 is dropped by the next F0, which decodes normally
+    const std::vector<uint8_t> first = encode(payloadOf(8));
+    const std::vector<uint8_t> second = encode(payloadOf(7));
+    std::vector<uint8_t> stream(first.begin(), first.begin() + 7);
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::COMPLETE), int(feed(decoder, stream)));
+    TEST_ASSERT_EQUAL(7, decoder.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payloadOf(7).data(), decoder.payload(), 7);
+    TEST_ASSERT_EQUAL(1, decoder.stats().messages);
+}
+
+void test_status_byte_inside_message() {
+    std::vector<uint8_t> message = encode(payloadOf(8));
+    message.insert(message.begin() + 5, 0xB0);  // CC status
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    feed(decoder, message);  // Aborted at the status byte, the rest is ignored
+    TEST_ASSERT_EQUAL(1, decoder.stats().errors);
+    TEST_ASSERT_EQUAL(0, decoder.stats().messages);
+}
+
+void test_overflow() {
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::ERROR), int(feed(decoder, encode(payloadOf(CAPACITY + 1)))));
+}
+
+void test_addressing() {
+    const std::vector<uint8_t> payload = payloadOf(3);
+
+    Decoder other(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::IGNORED), int(feed(other, encode(payload, DEVICE + 1))));
+    TEST_ASSERT_EQUAL(0, other.stats().errors);
+
+    Decoder all(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::COMPLETE),
+                      int(feed(all, encode(payload, midi::sysex::ALL_DEVICES))));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// State dump
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_state_dump_round_trip() {
+    FakeState source;
+    for (size_t i = 0; i < FakeState::SLOT_COUNT; ++i) source.slots[i] = uint16_t(i * 9001 + 7);
+    for (size_t i = 0; i < FakeState::BUTTON_COUNT; ++i) source.buttons[i] = i % 3 == 0;
+
+    std::vector<uint8_t> payload(Dump::BYTES);
+    TEST_ASSERT_EQUAL(Dump::BYTES, Dump::write(source, payload.data()));
+
+    Decoder decoder(MANUFACTURER, DEVICE);
+    TEST_ASSERT_EQUAL(int(Result::COMPLETE), int(feed(decoder, encode(payload))));
+
+    FakeState restored;
+    TEST_ASSERT_TRUE(Dump::read(decoder.payload(), decoder.size(), restored));
+    TEST_ASSERT_TRUE(restored.slots == source.slots);
+    TEST_ASSERT_TRUE(restored.buttons == source.buttons);
+}
+
+void test_state_dump_rejects_malformed() {
+    FakeState state;
+    std::vector<uint8_t> payload(Dump::BYTES);
+    Dump::write(state, payload.data());
+
+    std::vector<uint8_t> version = payload;
+    version[0] = Dump::FORMAT_VERSION + 1;
+    TEST_ASSERT_FALSE(Dump::read(version.data(), version.size(), state));
+    TEST_ASSERT_FALSE(Dump::read(payload.data(), payload.size() - 1, state));
+    TEST_ASSERT_FALSE(Dump::read(payload.data(), 2, state));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_packed_size);
+    RUN_TEST(test_round_trip_empty);
+    RUN_TEST(test_round_trip_1_byte);
+    RUN_TEST(test_round_trip_7_bytes);
+    RUN_TEST(test_round_trip_8_bytes);
+    RUN_TEST(test_round_trip_capacity);
+    RUN_TEST(test_checksum_sums_to_zero);
+    RUN_TEST(test_bad_checksum);
+    RUN_TEST(test_bad_data_byte);
+    RUN_TEST(test_truncated_before_end);
+    RUN_TEST(test_group_without_data);
+    RUN_TEST(test_no_command);
+    RUN_TEST(test_truncated_then_restarted);
+    RUN_TEST(test_status_byte_inside_message);
+    RUN_TEST(test_overflow);
+    RUN_TEST(test_addressing);
+    RUN_TEST(test_state_dump_round_trip);
+    RUN_TEST(test_state_dump_rejects_malformed);
+    return UNITY_END();
+}
@@ -0,0 +1,234 @@
+/**
+ * @file test_main.cpp
+ * @brief Host simulation of the idle-sleep loop and its load accounting (power/LoadMeter.hpp)
+ *
+ * TickClock::wait() is replayed against simulated periodic interrupt sources (tick
+ * timer, SysTick, scan and capture timers): the core sleeps until the next interrupt,
+ * each WFI exit is a wakeup, the loop resumes once a tick is due. ISR run time is not
+ * modelled (counted as idle).
+ *   - wakeups: every interrupt that finds the core asleep, once per instant
+ *     (coincident interrupts wake it once); checked against a brute-force count
+ *   - idle share and longest tick from the busy time fed per tick
+ *   - late ticks when a tick's work runs past the next one, no wakeup in between
+ *   - one Load per window
+ *
+ * The last test reports the wakeups per second of typical configurations.
+ *
+ * Run with: pio test -e native -f test_tickclock
+ */
+
+#include <unity.h>
+
+#include "power/LoadMeter.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using power::LoadMeter;
+
+namespace {
+
+constexpr uint32_t PERIOD_US = 500;  // APP_HZ = 2000
+
+struct Source {
+    uint32_t periodUs;
+    uint32_t phaseUs;
+};
+
+constexpr Source TICK = {PERIOD_US, 0};
+constexpr Source SYSTICK = {1000, 250};
+constexpr Source MIDI_CAPTURE = {100, 30};  // DAW context
+constexpr Source MUX_SCAN = {20, 7};        // Button::Mux::STEP_US
+
+/// Firings of `source` at or before `t`
+uint32_t firedBy(const Source& source, uint32_t t) {
+    return t < source.phaseUs ? 0 : (t - source.phaseUs) / source.periodUs + 1;
+}
+
+/// Firings of `source` in (from, to]
+uint32_t fired(const Source& source, uint32_t from, uint32_t to) {
+    return firedBy(source, to) - firedBy(source, from);
+}
+
+/**
+ * @brief The core running TickClock's loop: sleep until a tick is due, then do the
+ *        tick's work for busyUs(tick) microseconds
+ */
+class Core {
+public:
+    explicit Core(std::vector<Source> sources) : sources_(std::move(sources)) {
+        meter_.start(nowUs_);
+    }
+
+    void run(uint32_t ticks, const std::function<uint32_t(uint32_t)>& busyUs) {
+        for (uint32_t t = 0; t < ticks; ++t) {
+            meter_.busy(lastBusyUs_);  // wait(): the tick that just ran
+
+            uint32_t due = fired(TICK, checkedUs_, nowUs_);
+            checkedUs_ = nowUs_;
+            while (!due) {  // WFI until the next interrupt, any source
+                nowUs_ = nextInterrupt();
+                meter_.wakeup();
+                due = fired(TICK, checkedUs_, nowUs_);
+                checkedUs_ = nowUs_;
+            }
+            meter_.ticks(due);
+            windows_ += meter_.close(nowUs_);
+
+            lastBusyUs_ = busyUs(ticks_++);
+            busy_.emplace_back(nowUs_, nowUs_ + lastBusyUs_);
+            nowUs_ += lastBusyUs_;
+        }
+    }
+
+    /// Instants in (0, now] with an interrupt and the core not busy, counted one
+    /// microsecond at a time
+    uint32_t expectedWakeups() const {
+        std::vector<bool> busy(nowUs_ + 1, false);
+        for (const auto& [from, to] : busy_) {
+            for (uint32_t t = from + 1; t <= to && t <= nowUs_; ++t) busy[t] = true;
+        }
+        uint32_t wakeups = 0;
+        for (uint32_t t = 1; t <= nowUs_; ++t) {
+            bool any = false;
+            for (const Source& s : sources_) any = any || fired(s, t - 1, t);
+            wakeups += any && !busy[t];
+        }
+        return wakeups;
+    }
+
+    const LoadMeter& meter() const { return meter_; }
+    uint32_t windows() const { return windows_; }
+
+private:
+    uint32_t nextInterrupt() const {
+        uint32_t next = UINT32_MAX;
+        for (const Source& s : sources_) {
+            const uint32_t n = s.phaseUs + firedBy(s, nowUs_) * s.periodUs;
+            if (n < next) next = n;
+        }
+        return next;
+    }
+
+    std::vector<Source> sources_;
+    LoadMeter meter_;
+    uint32_t nowUs_ = 0;
+    uint32_t checkedUs_ = 0;
+    uint32_t lastBusyUs_ = 0;
+    uint32_t ticks_ = 0;
+    uint32_t windows_ = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> busy_;  ///< Tick work, (start, end]
+};
+
+constexpr uint32_t TICKS_PER_SEC = 1'000'000 / PERIOD_US;
+
+uint32_t constantBusy(uint32_t) { return 20; }
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_idle_wakeups() {
+    Core core({TICK, SYSTICK});
+    core.run(3 * TICKS_PER_SEC + 1, constantBusy);
+    TEST_ASSERT_EQUAL(3, core.windows());
+    const LoadMeter::Load& load = core.meter().load();
+    TEST_ASSERT_EQUAL(3000, load.wakeupsPerSec);  // 2000 ticks + 1000 SysTick
+    TEST_ASSERT_EQUAL(960, load.idlePermille);   // 20 us of 500
+    TEST_ASSERT_EQUAL(20, load.busyUsMax);
+    TEST_ASSERT_EQUAL(0, core.meter().stats().lateTicks);
+    TEST_ASSERT_EQUAL(core.expectedWakeups(), core.meter().stats().wakeups);
+}
+
+void test_coincident_interrupts_wake_once() {
+    Core core({TICK, {1000, 0}});  // SysTick on every other tick
+    core.run(TICKS_PER_SEC + 1, constantBusy);
+    TEST_ASSERT_EQUAL(2000, core.meter().load().wakeupsPerSec);
+    TEST_ASSERT_EQUAL(core.expectedWakeups(), core.meter().stats().wakeups);
+}
+
+void test_busy_hides_interrupts() {
+    // Fast sources: those firing while a tick runs do not wake the core
+    Core core({TICK, SYSTICK, MIDI_CAPTURE, MUX_SCAN});
+    core.run(TICKS_PER_SEC + 1, constantBusy);
+    const uint32_t wakeups = core.meter().load().wakeupsPerSec;
+    TEST_ASSERT_EQUAL(core.expectedWakeups(), core.meter().stats().wakeups);
+    TEST_ASSERT_TRUE(wakeups < 2000 + 1000 + 10'000 + 50'000);
+    TEST_ASSERT_TRUE(wakeups > 50'000);
+}
+
+void test_late_ticks() {
+    // Every 10th tick runs 1200 us: two ticks come due meanwhile, the next wait returns
+    // 2 at once (one late). The last long tick has no wait after it
+    Core core({TICK, SYSTICK});
+    core.run(TICKS_PER_SEC, [](uint32_t tick) { return tick % 10 == 9 ? 1200u : 20u; });
+    const LoadMeter::Stats& stats = core.meter().stats();
+    TEST_ASSERT_EQUAL(TICKS_PER_SEC / 10 - 1, stats.lateTicks);
+    TEST_ASSERT_EQUAL(TICKS_PER_SEC + stats.lateTicks, stats.ticks);
+    TEST_ASSERT_EQUAL(core.expectedWakeups(), stats.wakeups);
+
+    core.run(TICKS_PER_SEC, [](uint32_t tick) { return tick % 10 == 9 ? 1200u : 20u; });
+    TEST_ASSERT_EQUAL(1200, core.meter().load().busyUsMax);
+    TEST_ASSERT_TRUE(core.meter().load().idlePermille < 960);
+}
+
+void test_overloaded_never_sleeps() {
+    Core core({TICK, SYSTICK});
+    core.run(3 * TICKS_PER_SEC, [](uint32_t) { return PERIOD_US + 100; });
+    TEST_ASSERT_EQUAL(0, core.meter().load().idlePermille);
+    TEST_ASSERT_EQUAL(0, core.meter().load().wakeupsPerSec);
+    TEST_ASSERT_TRUE(core.meter().stats().lateTicks > 0);
+}
+
+void test_window() {
+    LoadMeter meter(1'000'000);
+    meter.start(100);
+    meter.busy(50);
+    meter.wakeup();
+    TEST_ASSERT_FALSE(meter.close(999'999));
+    TEST_ASSERT_TRUE(meter.close(1'000'100));
+    TEST_ASSERT_EQUAL(1, meter.load().wakeupsPerSec);
+    TEST_ASSERT_EQUAL(50, meter.load().busyUsMax);
+    TEST_ASSERT_FALSE(meter.close(1'500'000));  // Next window starts at the close
+    TEST_ASSERT_TRUE(meter.close(2'000'100));
+    TEST_ASSERT_EQUAL(0, meter.load().busyUsMax);
+    TEST_ASSERT_EQUAL(1000, meter.load().idlePermille);
+}
+
+void test_report_configurations() {
+    struct Config {
+        const char* name;
+        std::vector<Source> sources;
+    };
+    const Config configs[] = {
+        {"tick + SysTick", {TICK, SYSTICK}},
+        {"+ MIDI capture", {TICK, SYSTICK, MIDI_CAPTURE}},
+        {"+ mux scan", {TICK, SYSTICK, MIDI_CAPTURE, MUX_SCAN}},
+    };
+    char line[200];
+    int length = std::snprintf(line, sizeof(line), "Wakeups/s at 20 us per tick:");
+    for (const Config& config : configs) {
+        Core core(config.sources);
+        core.run(TICKS_PER_SEC + 1, constantBusy);
+        length += std::snprintf(line + length, sizeof(line) - size_t(length), " %s %u;",
+                                config.name, unsigned(core.meter().load().wakeupsPerSec));
+    }
+    std::snprintf(line + length, sizeof(line) - size_t(length), " (model)");
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_wakeups);
+    RUN_TEST(test_coincident_interrupts_wake_once);
+    RUN_TEST(test_busy_hides_interrupts);
+    RUN_TEST(test_late_ticks);
+    RUN_TEST(test_overloaded_never_sleeps);
+    RUN_TEST(test_window);
+    RUN_TEST(test_report_configurations);
+    return UNITY_END();
+}
@@ -0,0 +1,274 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests of the USB-MIDI event packet decoder (midi/UsbMidiParser.hpp)
+ *
+ * Packets are built as the USB stack returns them (little-endian word: CIN and
+ * cable in byte 0, then the MIDI bytes):
+ *   - CIN decode: CC, SysEx start/continue/end (1-3 bytes), realtime; notes, program
+ *     changes and system common counted as ignored; the empty packet skipped
+ *   - 7-bit CC widening, channel from the status, cable ignored
+ *   - 14-bit pairs: MSB then LSB, per channel; orphan and repeated LSBs dropped;
+ *     LSB numbers of unpaired MSBs stay plain controllers
+ *   - SinkPair forwards to both sinks in order
+ *
+ * The benchmark decodes a mix of CCs, 14-bit pairs and clock ticks and reports
+ * packets per second.
+ *
+ * Run with: pio test -e native -f test_usbmidi
+ */
+
+#include <unity.h>
+
+#include "midi/UsbMidiParser.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using midi::UsbMidiParser;
+
+namespace {
+
+uint32_t packet(uint8_t cin, uint8_t status, uint8_t data1 = 0, uint8_t data2 = 0,
+                uint8_t cable = 0) {
+    return uint32_t(cin | cable << 4) | uint32_t(status) << 8 | uint32_t(data1) << 16 |
+           uint32_t(data2) << 24;
+}
+
+uint32_t cc(uint8_t channel, uint8_t number, uint8_t value) {
+    return packet(0x0B, uint8_t(0xB0 | channel), number, value);
+}
+
+/// Records everything it receives
+struct Recorder : midi::MidiSink {
+    struct Cc {
+        uint8_t channel;
+        uint8_t cc;
+        uint16_t value;
+    };
+    std::vector<Cc> ccs;
+    std::vector<uint8_t> sysEx;
+    uint32_t sysExEnds = 0;
+    std::vector<uint8_t> realtime;
+    std::vector<uint32_t> realtimeUs;
+
+    void onControlChange(uint8_t channel, uint8_t number, uint16_t value14) {
+        ccs.push_back({channel, number, value14});
+    }
+    void onSysEx(const uint8_t* data, uint8_t size, bool end) {
+        sysEx.insert(sysEx.end(), data, data + size);
+        sysExEnds += end;
+    }
+    void onRealtime(uint8_t status, uint32_t timeUs) {
+        realtime.push_back(status);
+        realtimeUs.push_back(timeUs);
+    }
+};
+
+constexpr std::array<uint8_t, 2> HIRES = {1, 7};  // Mod wheel, volume
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_cin_decode() {
+    UsbMidiParser parser;
+    Recorder sink;
+    parser.parse(0, 10, sink);  // No packet
+    TEST_ASSERT_EQUAL(0, parser.stats().packets);
+
+    parser.parse(cc(0, 20, 1), 0, sink);
+    parser.parse(packet(0x0F, 0xF8), 1234, sink);  // Clock
+    parser.parse(packet(0x0F, 0xFA), 1300, sink);  // Start
+    parser.parse(packet(0x09, 0x90, 60, 100), 0, sink);  // Note on
+    parser.parse(packet(0x08, 0x80, 60, 0), 0, sink);    // Note off
+    parser.parse(packet(0x0C, 0xC0, 5), 0, sink);        // Program change
+    parser.parse(packet(0x05, 0xF6), 0, sink);           // Tune request (system common)
+    parser.parse(packet(0x0F, 0xF6), 0, sink);           // Single byte below realtime
+
+    TEST_ASSERT_EQUAL(8, parser.stats().packets);
+    TEST_ASSERT_EQUAL(1, parser.stats().controlChanges);
+    TEST_ASSERT_EQUAL(5, parser.stats().ignored);
+    TEST_ASSERT_EQUAL(1, sink.ccs.size());
+    TEST_ASSERT_EQUAL(2, sink.realtime.size());
+    TEST_ASSERT_EQUAL(0xF8, sink.realtime[0]);
+    TEST_ASSERT_EQUAL(1234, sink.realtimeUs[0]);
+    TEST_ASSERT_EQUAL(0xFA, sink.realtime[1]);
+    TEST_ASSERT_EQUAL(0, sink.sysEx.size());
+}
+
+void test_cc_widen_and_channel() {
+    UsbMidiParser parser;
+    Recorder sink;
+    parser.parse(cc(3, 74, 0), 0, sink);
+    parser.parse(cc(3, 74, 64), 0, sink);
+    parser.parse(cc(15, 74, 127), 0, sink);
+    parser.parse(packet(0x0B, 0xB2, 74, 127, 5), 0, sink);  // Cable 5: same decode
+    parser.parse(packet(0x0B, 0xB0, 0xCA, 0xFF), 0, sink);  // Bytes masked to 7 bits
+
+    TEST_ASSERT_EQUAL(5, sink.ccs.size());
+    TEST_ASSERT_EQUAL(0, sink.ccs[0].value);
+    TEST_ASSERT_EQUAL(64 << 7 | 64, sink.ccs[1].value);
+    TEST_ASSERT_EQUAL(15, sink.ccs[2].channel);
+    TEST_ASSERT_EQUAL(midi::VALUE14_MAX, sink.ccs[2].value);
+    TEST_ASSERT_EQUAL(2, sink.ccs[3].channel);
+    TEST_ASSERT_EQUAL(74, sink.ccs[3].cc);
+    TEST_ASSERT_EQUAL(0x4A, sink.ccs[4].cc);
+    TEST_ASSERT_EQUAL(midi::VALUE14_MAX, sink.ccs[4].value);
+}
+
+void test_hires_pair() {
+    UsbMidiParser parser(UsbMidiParser::hiresMask(HIRES));
+    Recorder sink;
+    parser.parse(cc(0, 7, 100), 0, sink);      // MSB: usable alone
+    parser.parse(cc(0, 7 + 32, 37), 0, sink);  // LSB: refines it
+    TEST_ASSERT_EQUAL(2, sink.ccs.size());
+    TEST_ASSERT_EQUAL(7, sink.ccs[0].cc);
+    TEST_ASSERT_EQUAL(100 << 7 | 100, sink.ccs[0].value);
+    TEST_ASSERT_EQUAL(7, sink.ccs[1].cc);
+    TEST_ASSERT_EQUAL(100 << 7 | 37, sink.ccs[1].value);
+
+    // Full range
+    parser.parse(cc(0, 1, 127), 0, sink);
+    parser.parse(cc(0, 33, 127), 0, sink);
+    TEST_ASSERT_EQUAL(midi::VALUE14_MAX, sink.ccs.back().value);
+    parser.parse(cc(0, 1, 0), 0, sink);
+    parser.parse(cc(0, 33, 0), 0, sink);
+    TEST_ASSERT_EQUAL(0, sink.ccs.back().value);
+    TEST_ASSERT_EQUAL(0, parser.stats().orphanLsbs);
+}
+
+void test_hires_orphans() {
+    UsbMidiParser parser(UsbMidiParser::hiresMask(HIRES));
+    Recorder sink;
+    parser.parse(cc(0, 39, 5), 0, sink);  // LSB before any MSB
+    TEST_ASSERT_EQUAL(0, sink.ccs.size());
+    TEST_ASSERT_EQUAL(1, parser.stats().orphanLsbs);
+
+    parser.parse(cc(0, 7, 10), 0, sink);
+    parser.parse(cc(0, 39, 5), 0, sink);
+    parser.parse(cc(0, 39, 6), 0, sink);  // Repeated LSB: nothing to refine
+    TEST_ASSERT_EQUAL(2, sink.ccs.size());
+    TEST_ASSERT_EQUAL(2, parser.stats().orphanLsbs);
+
+    parser.parse(cc(1, 7, 10), 0, sink);  // MSB on channel 2...
+    parser.parse(cc(0, 39, 5), 0, sink);  // ...does not pair with channel 1
+    TEST_ASSERT_EQUAL(3, sink.ccs.size());
+    TEST_ASSERT_EQUAL(3, parser.stats().orphanLsbs);
+}
+
+void test_hires_only_configured() {
+    // CC 38 pairs with CC 6, not configured: a plain 7-bit controller. CCs above 31
+    // are not MSBs
+    constexpr std::array<uint8_t, 3> msbs = {1, 7, 40};
+    TEST_ASSERT_EQUAL((1u << 1) | (1u << 7), UsbMidiParser::hiresMask(msbs));
+    UsbMidiParser parser(UsbMidiParser::hiresMask(msbs));
+    Recorder sink;
+    parser.parse(cc(0, 38, 127), 0, sink);
+    parser.parse(cc(0, 6, 1), 0, sink);
+    TEST_ASSERT_EQUAL(2, sink.ccs.size());
+    TEST_ASSERT_EQUAL(38, sink.ccs[0].cc);
+    TEST_ASSERT_EQUAL(midi::VALUE14_MAX, sink.ccs[0].value);
+    TEST_ASSERT_EQUAL(0, parser.stats().orphanLsbs);
+}
+
+void test_sysex() {
+    UsbMidiParser parser;
+    Recorder sink;
+    // F0 7D 01 02 03 04 05 F7: start, continue, end with 2 bytes
+    parser.parse(packet(0x04, 0xF0, 0x7D, 0x01), 0, sink);
+    parser.parse(packet(0x04, 0x02, 0x03, 0x04), 0, sink);
+    parser.parse(packet(0x06, 0x05, 0xF7), 0, sink);
+    // F0 7D F7: end with 3 bytes; F0 7D 01 then a lone F7
+    parser.parse(packet(0x07, 0xF0, 0x7D, 0xF7), 0, sink);
+    parser.parse(packet(0x04, 0xF0, 0x7D, 0x01), 0, sink);
+    parser.parse(packet(0x05, 0xF7), 0, sink);
+
+    const std::vector<uint8_t> expected = {0xF0, 0x7D, 0x01, 0x02, 0x03, 0x04, 0x05, 0xF7,
+                                           0xF0, 0x7D, 0xF7, 0xF0, 0x7D, 0x01, 0xF7};
+    TEST_ASSERT_TRUE(sink.sysEx == expected);
+    TEST_ASSERT_EQUAL(3, sink.sysExEnds);
+    TEST_ASSERT_EQUAL(expected.size(), parser.stats().sysExBytes);
+    TEST_ASSERT_EQUAL(0, parser.stats().ignored);
+}
+
+void test_sink_pair() {
+    Recorder first;
+    Recorder second;
+    midi::SinkPair<Recorder, Recorder> pair(first, second);
+    UsbMidiParser parser;
+    parser.parse(cc(0, 10, 1), 0, pair);
+    parser.parse(packet(0x0F, 0xFC), 77, pair);
+    parser.parse(packet(0x05, 0xF7), 0, pair);
+    for (const Recorder* sink : {&first, &second}) {
+        TEST_ASSERT_EQUAL(1, sink->ccs.size());
+        TEST_ASSERT_EQUAL(77, sink->realtimeUs[0]);
+        TEST_ASSERT_EQUAL(1, sink->sysExEnds);
+    }
+}
+
+namespace {
+/// Sink doing the minimum so the decode is not optimized away
+struct Sum : midi::MidiSink {
+    uint32_t total = 0;
+    void onControlChange(uint8_t channel, uint8_t number, uint16_t value14) {
+        total += channel + number + value14;
+    }
+    void onRealtime(uint8_t status, uint32_t timeUs) { total += status + timeUs; }
+};
+}  // namespace
+
+void test_benchmark_packets() {
+    // DAW feedback traffic: 7-bit CCs on 16 channels, 14-bit pairs, clock ticks
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 rng(35);
+    std::vector<uint32_t> packets;
+    while (packets.size() < 4096) {
+        const uint8_t channel = uint8_t(rng() % 16);
+        switch (rng() % 4) {
+            case 0:
+            case 1: packets.push_back(cc(channel, uint8_t(16 + rng() % 16), rng() & 0x7F)); break;
+            case 2:
+                packets.push_back(cc(channel, 7, rng() & 0x7F));
+                packets.push_back(cc(channel, 39, rng() & 0x7F));
+                break;
+            default: packets.push_back(packet(0x0F, 0xF8)); break;
+        }
+    }
+    packets.resize(4096);
+
+    UsbMidiParser parser(UsbMidiParser::hiresMask(HIRES));
+    Sum sink;
+    constexpr uint32_t ROUNDS = 2000;
+    const auto start = Clock::now();
+    for (uint32_t r = 0; r < ROUNDS; ++r) {
+        for (uint32_t i = 0; i < packets.size(); ++i) parser.parse(packets[i], i, sink);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+                      (double(ROUNDS) * packets.size());
+    TEST_ASSERT_EQUAL(ROUNDS * packets.size(), parser.stats().packets);
+    TEST_ASSERT_TRUE(sink.total > 0);
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "Mixed CC / 14-bit / clock packets: %.2f ns/packet = %.0f M packets/s (host)",
+                  ns, 1000.0 / ns);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cin_decode);
+    RUN_TEST(test_cc_widen_and_channel);
+    RUN_TEST(test_hires_pair);
+    RUN_TEST(test_hires_orphans);
+    RUN_TEST(test_hires_only_configured);
+    RUN_TEST(test_sysex);
+    RUN_TEST(test_sink_pair);
+    RUN_TEST(test_benchmark_packets);
+    return UNITY_END();
+}